@@ -0,0 +1,239 @@
+/*
+    Checks the typed value parsers against a table of inputs and expected results. Every input goes through
+    convertAll (the eight digits at a time integer parser, path normalization) and, for the scalar types,
+    through setRuntime (the parser behind the typed getters), and both must give the expected result.
+
+    Build and run: make check
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <eloarg.h>
+
+typedef struct {
+    ArgDataType type;
+    const char *input;
+    bool valid;
+    EloArgValue expected;
+    const char *path; // Expected normalized path
+} Conversion;
+
+#define INT64(input, valid, value) { ARG_TYPE_INT64, input, valid, { .i64 = value }, NULL }
+#define UINT64(input, valid, value) { ARG_TYPE_UINT64, input, valid, { .u64 = value }, NULL }
+#define DOUBLE(input, valid, value) { ARG_TYPE_DOUBLE, input, valid, { .f64 = value }, NULL }
+#define SIZE(input, valid, value) { ARG_TYPE_SIZE, input, valid, { .u64 = value }, NULL }
+#define DURATION(input, valid, value) { ARG_TYPE_DURATION, input, valid, { .u64 = value }, NULL }
+#define PATH(input, path) { ARG_TYPE_PATH, input, true, { 0 }, path }
+
+static const Conversion conversions[] = {
+    // Integers, the fast parser takes up to 19 digits eight at a time
+    INT64("0", true, 0),
+    INT64("-0", true, 0),
+    INT64("+42", true, 42),
+    INT64("1234567", true, 1234567),
+    INT64("12345678", true, 12345678),
+    INT64("123456789", true, 123456789),
+    INT64("1234567812345678", true, 1234567812345678),
+    INT64("0012345678", true, 12345678),
+    INT64("1234567a", false, 0),
+    INT64("12345678a", false, 0),
+    INT64("1234567/", false, 0),
+    INT64("1234567:", false, 0),
+    INT64("1 ", false, 0),
+    INT64("--5", false, 0),
+    INT64("9223372036854775807", true, INT64_MAX),
+    INT64("9223372036854775808", false, 0),
+    INT64("-9223372036854775808", true, INT64_MIN),
+    INT64("-9223372036854775809", false, 0),
+    INT64("00000000000000000000042", true, 42),
+    UINT64("99999999", true, 99999999),
+    UINT64("9999999999999999999", true, 9999999999999999999ULL),
+    UINT64("18446744073709551615", true, UINT64_MAX),
+    UINT64("18446744073709551616", false, 0),
+    UINT64("-1", false, 0),
+
+    // Doubles, exact on the fast path (up to 19 digits, mantissa up to 2^53, |exponent| up to 22)
+    DOUBLE("1.5", true, 1.5),
+    DOUBLE("0.1", true, 0.1),
+    DOUBLE("-2.5e-3", true, -2.5e-3),
+    DOUBLE(".5", true, 0.5),
+    DOUBLE("5.", true, 5.0),
+    DOUBLE("9007199254740992", true, 9007199254740992.0),
+    DOUBLE("9007199254740993", true, 9007199254740993.0),
+    DOUBLE("1e22", true, 1e22),
+    DOUBLE("1e23", true, 1e23),
+    DOUBLE("1e-22", true, 1e-22),
+    DOUBLE("1e-23", true, 1e-23),
+    DOUBLE("1234567890123456789", true, 1234567890123456789.0),
+    DOUBLE("12345678901234567890", true, 12345678901234567890.0),
+    DOUBLE("0.30000000000000000000001", true, 0.30000000000000000000001),
+    DOUBLE("1.5e30", true, 1.5e30),
+    DOUBLE("1.7976931348623157e308", true, 1.7976931348623157e308),
+    DOUBLE("1e309", false, 0),
+    DOUBLE("1,5", false, 0),
+    DOUBLE("1,5e30", false, 0),
+    DOUBLE("e5", false, 0),
+    DOUBLE("1e", false, 0),
+    DOUBLE("inf", false, 0),
+    DOUBLE("nan", false, 0),
+
+    // Sizes, a fraction must come to whole bytes
+    SIZE("512", true, 512),
+    SIZE("4K", true, 4096),
+    SIZE("1k", true, 1024),
+    SIZE("4KiB", true, 4096),
+    SIZE("4KB", true, 4000),
+    SIZE("2MB", true, 2000000),
+    SIZE("1.5K", true, 1536),
+    SIZE("1.5GiB", true, 1610612736),
+    SIZE("0.5KB", true, 500),
+    SIZE("0.001KB", true, 1),
+    SIZE("0.25EiB", true, 288230376151711744ULL),
+    SIZE("15EiB", true, 15ULL << 60),
+    SIZE("2.000000000000000000000000GiB", true, 2147483648ULL),
+    SIZE("1.5B", false, 0),
+    SIZE("1.5", false, 0),
+    SIZE("0.1K", false, 0),
+    SIZE("0.0001KB", false, 0),
+    SIZE("16EiB", false, 0),
+    SIZE("1 K", false, 0),
+    SIZE("1Q", false, 0),
+
+    // Durations in nanoseconds
+    DURATION("90", true, 90000000000ULL),
+    DURATION("30s", true, 30000000000ULL),
+    DURATION("250ms", true, 250000000ULL),
+    DURATION("1h30m", true, 5400000000000ULL),
+    DURATION("1m30s", true, 90000000000ULL),
+    DURATION("1.5d", true, 129600000000000ULL),
+    DURATION("1h30", false, 0),
+    DURATION("5x", false, 0),
+    DURATION("s", false, 0),
+
+    // Paths, normalized lexically
+    PATH("a//b/./c/../d", "a/b/d"),
+    PATH("/../x", "/x"),
+    PATH("../../a", "../../a"),
+    PATH("a/..", "."),
+    PATH("a/b/../../..", ".."),
+    PATH("./", "."),
+    PATH("/", "/"),
+    PATH("/a/b/", "/a/b")
+};
+
+#define CONVERSION_COUNT (sizeof(conversions) / sizeof(*conversions))
+
+static bool sameValue(ArgDataType type, EloArgValue a, EloArgValue b) {
+    if(type == ARG_TYPE_INT64)
+        return a.i64 == b.i64;
+    else if(type == ARG_TYPE_DOUBLE)
+        return a.f64 == b.f64;
+
+    return a.u64 == b.u64;
+}
+
+static void printValue(ArgDataType type, EloArgValue value) {
+    if(type == ARG_TYPE_INT64)
+        printf("%lld", (long long)value.i64);
+    else if(type == ARG_TYPE_DOUBLE)
+        printf("%.17g", value.f64);
+    else
+        printf("%llu", (unsigned long long)value.u64);
+}
+
+static bool report(const Conversion *conversion, const char *through, bool valid, EloArgValue value, const char *path) {
+    bool correct = valid == conversion->valid &&
+        (!valid || (conversion->path ? strcmp(path, conversion->path) == 0 : sameValue(conversion->type, value, conversion->expected)));
+
+    if(!correct) {
+        printf("FAILED  '%s' through %s: ", conversion->input, through);
+
+        if(!valid)
+            fputs("invalid", stdout);
+        else if(conversion->path)
+            fputs(path, stdout);
+        else
+            printValue(conversion->type, value);
+
+        fputs(", expected ", stdout);
+
+        if(!conversion->valid)
+            fputs("invalid", stdout);
+        else if(conversion->path)
+            fputs(conversion->path, stdout);
+        else
+            printValue(conversion->type, conversion->expected);
+
+        putchar('\n');
+    }
+
+    return correct;
+}
+
+// Converts the inputs of one type as the values of a repeated option, then one by one with setRuntime
+static size_t checkType(ArgDataType type) {
+    static char *argv[CONVERSION_COUNT + 1];
+    static char arguments[CONVERSION_COUNT][128];
+    const Conversion *rows[CONVERSION_COUNT];
+    size_t count = 0, failures = 0;
+
+    argv[0] = "convert_check";
+
+    for(size_t i = 0; i < CONVERSION_COUNT; i++)
+        if(conversions[i].type == type) {
+            rows[count] = &conversions[i];
+            snprintf(arguments[count], sizeof(arguments[count]), "--value=%s", conversions[i].input);
+            argv[count + 1] = arguments[count];
+            count++;
+        }
+
+    EloArg *eloarg = eloArgInit(2);
+    EloArgId valueId = eloarg->add(NULL, "value", "Values to convert.", ARG_OPTIONAL);
+    EloArgId typedId = eloarg->add(NULL, "typed", "Typed option for setRuntime.", ARG_OPTIONAL);
+    EloArgArray array;
+
+    if(type != ARG_TYPE_PATH)
+        eloarg->setType(typedId, type);
+
+    eloarg->parse(count + 1, argv);
+    eloarg->convertAll(valueId, type, &array);
+
+    for(size_t i = 0, invalid = 0; i < count; i++) {
+        bool valid = invalid == array.invalidCount || array.invalid[invalid] != i;
+        EloArgValue value = { 0 };
+        const char *path = NULL;
+
+        invalid += !valid;
+
+        if(type == ARG_TYPE_PATH)
+            path = ((char **)array.values)[i];
+        else
+            value = ((EloArgValue *)array.values)[i];
+
+        failures += !report(rows[i], "convertAll", valid, value, path);
+
+        if(type != ARG_TYPE_PATH) {
+            valid = eloarg->setRuntime("typed", rows[i]->input);
+            failures += !report(rows[i], "setRuntime", valid, eloarg->getRuntime(typedId), NULL);
+        }
+    }
+
+    eloarg->freeArray(&array);
+    eloarg->free();
+
+    return failures;
+}
+
+int main() {
+    static const ArgDataType types[] = { ARG_TYPE_INT64, ARG_TYPE_UINT64, ARG_TYPE_DOUBLE, ARG_TYPE_SIZE, ARG_TYPE_DURATION, ARG_TYPE_PATH };
+    size_t failures = 0;
+
+    for(size_t i = 0; i < sizeof(types) / sizeof(*types); i++)
+        failures += checkType(types[i]);
+
+    printf("%zu conversions checked, %zu failed\n", CONVERSION_COUNT, failures);
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,230 @@
+/*
+    Checks that parseParallel gives exactly the results of parse. Each case runs both on the same
+    generated command line in child processes and compares everything they print, exit status included.
+    The cases put pending options, '--', ARG_INFO options and errors on and around the chunk boundaries.
+
+    Build and run: make check
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <eloarg.h>
+
+#define ARGUMENT_COUNT (4 * ELOARG_PARALLEL_CHUNK_SIZE + 124) // Program name included
+#define THREADS 4
+#define MAX_PLACEMENTS 4
+
+// First argument of a chunk, parseParallel splits the arguments after the program name
+#define EDGE(chunk) (1 + (chunk) * ELOARG_PARALLEL_CHUNK_SIZE)
+
+typedef struct {
+    size_t index;
+    const char *argument;
+} Placement;
+
+typedef struct {
+    const char *name;
+    Placement placements[MAX_PLACEMENTS];
+} Case;
+
+static const Case cases[] = {
+    { "options and positionals only", { { 0 } } },
+    { "long option waiting for its value across a chunk edge", {
+        { EDGE(1) - 2, "plain" }, { EDGE(1) - 1, "--out" }, { EDGE(1), "edge-value" } } },
+    { "short bundle waiting for its value across a chunk edge", {
+        { EDGE(2) - 2, "plain" }, { EDGE(2) - 1, "-vo" }, { EDGE(2), "edge-value" } } },
+    { "'--' inside a chunk", { { 19999, "plain" }, { 20000, "--" } } },
+    { "'--' ending a chunk", { { EDGE(1) - 2, "plain" }, { EDGE(1) - 1, "--" } } },
+    { "'--' starting a chunk", { { EDGE(2) - 1, "plain" }, { EDGE(2), "--" } } },
+    { "ARG_INFO option in an earlier chunk than an error", { { 99, "plain" }, { 100, "--help" }, { 50000, "--bogus" } } },
+    { "ARG_INFO option starting a chunk", { { EDGE(1) - 1, "plain" }, { EDGE(1), "-h" } } },
+    { "error in a later chunk", { { 39999, "plain" }, { 40000, "--bogus" } } },
+    { "errors in two chunks, the first one wins", { { 16999, "plain" }, { 17000, "-Z" }, { 50000, "--bogus" } } },
+    { "missing value across a chunk edge", { { EDGE(3) - 2, "plain" }, { EDGE(3) - 1, "--out" }, { EDGE(3), "-v" } } },
+    { "missing value at the end", { { ARGUMENT_COUNT - 2, "plain" }, { ARGUMENT_COUNT - 1, "--out" } } },
+    { "value not allowed after '='", { { 30000, "--verbose=1" } } }
+};
+
+static const char *positionals[] = { "a.txt", "dir/b.txt", "-", "x" };
+
+static uint64_t randomState;
+
+// xorshift64, the same command line for every run
+static uint64_t nextRandom() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+
+    return randomState;
+}
+
+// Valid arguments: every option taking a separate value is followed by one
+static void generateArguments(char **argv, uint64_t seed) {
+    randomState = seed;
+    argv[0] = "parallel_check";
+
+    for(size_t i = 1; i < ARGUMENT_COUNT; i++) {
+        switch(nextRandom() % 10) {
+            case 0:
+                argv[i] = "-v";
+                break;
+            case 1:
+                argv[i] = "--verbose";
+                break;
+            case 2:
+                argv[i] = "--out=inline";
+                break;
+            case 3:
+                argv[i] = "-ocompact";
+                break;
+            case 4:
+            case 5:
+                argv[i] = (char *)(nextRandom() % 2 ? "--out" : (nextRandom() % 2 ? "-o" : "-vo"));
+
+                if(i + 1 < ARGUMENT_COUNT)
+                    argv[++i] = "separate";
+                break;
+            case 6:
+                argv[i] = "--level=3";
+                break;
+            default:
+                argv[i] = (char *)positionals[nextRandom() % (sizeof(positionals) / sizeof(*positionals))];
+        }
+    }
+}
+
+static void printResults(EloArg *eloarg) {
+    static const char *names[] = { "verbose", "out", "level", "help" };
+    size_t count;
+    char **arguments = eloarg->positionals(&count);
+
+    for(size_t i = 0; i < count; i++)
+        printf("positional %s\n", arguments[i]);
+
+    arguments = eloarg->rest(&count);
+
+    for(size_t i = 0; i < count; i++)
+        printf("rest %s\n", arguments[i]);
+
+    const EloArgEvent *events = eloarg->events(&count);
+
+    for(size_t i = 0; i < count; i++)
+        printf("event %u %zu %s\n", events[i].id, events[i].index, events[i].value ? events[i].value : "(none)");
+
+    for(size_t i = 0; i < sizeof(names) / sizeof(*names); i++)
+        printf("option %s has=%d count=%zu value=%s\n", names[i], eloarg->has(names[i]),
+            eloarg->getCount(names[i]), eloarg->get(names[i]) ? eloarg->get(names[i]) : "(none)");
+}
+
+// Parses in a child process, errors exit it, and returns everything it printed followed by its exit status
+static char *runParse(char **argv, bool parallel) {
+    int fds[2];
+
+    if(pipe(fds) < 0) {
+        perror("pipe");
+        exit(EXIT_FAILURE);
+    }
+
+    pid_t pid = fork();
+
+    if(pid < 0) {
+        perror("fork");
+        exit(EXIT_FAILURE);
+    }
+    else if(pid == 0) {
+        dup2(fds[1], STDOUT_FILENO);
+        dup2(fds[1], STDERR_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+
+        EloArg *eloarg = eloArgInit(4);
+
+        eloarg->add("v", "verbose", "Increase verbosity level.", ARG_NONE);
+        eloarg->add("o", "out", "Output file.", ARG_OPTIONAL);
+        eloarg->add("l", "level", "Level.", ARG_OPTIONAL);
+        eloarg->add("h", "help", "Displays help information.", ARG_INFO);
+
+        if(parallel)
+            eloarg->parseParallel(ARGUMENT_COUNT, argv, THREADS);
+        else
+            eloarg->parse(ARGUMENT_COUNT, argv);
+
+        printResults(eloarg);
+        eloarg->free();
+        fflush(stdout);
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(fds[1]);
+
+    size_t length = 0, capacity = 1 << 20;
+    char *output = malloc(capacity);
+    ssize_t bytesRead;
+
+    while(output && (bytesRead = read(fds[0], output + length, capacity - length - 32)) > 0) {
+        length += bytesRead;
+
+        if(capacity - length - 32 == 0 && !(output = realloc(output, capacity *= 2)))
+            break;
+    }
+
+    close(fds[0]);
+
+    int status;
+
+    waitpid(pid, &status, 0);
+
+    if(!output) {
+        fputs("Cannot allocate a memory for the parse output.\n", stderr);
+        exit(EXIT_FAILURE);
+    }
+
+    snprintf(output + length, 32, "exit %d\n", WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+
+    return output;
+}
+
+// Line number of the first difference
+static size_t firstDifference(const char *a, const char *b) {
+    size_t line = 1;
+
+    for(; *a && *a == *b; a++, b++)
+        line += *a == '\n';
+
+    return line;
+}
+
+int main() {
+    static char *argv[ARGUMENT_COUNT + 1];
+    size_t failures = 0;
+    size_t caseCount = sizeof(cases) / sizeof(*cases);
+
+    for(size_t i = 0; i < caseCount; i++) {
+        const Case *check = &cases[i];
+
+        generateArguments(argv, 0x9e3779b97f4a7c15ULL + i);
+
+        for(size_t j = 0; j < MAX_PLACEMENTS && check->placements[j].argument; j++)
+            argv[check->placements[j].index] = (char *)check->placements[j].argument;
+
+        char *serial = runParse(argv, false);
+        char *parallel = runParse(argv, true);
+
+        if(strcmp(serial, parallel) == 0)
+            printf("ok      %s\n", check->name);
+        else {
+            printf("FAILED  %s (first difference on line %zu)\n", check->name, firstDifference(serial, parallel));
+            failures++;
+        }
+
+        free(serial);
+        free(parallel);
+    }
+
+    printf("%zu of %zu cases match\n", caseCount - failures, caseCount);
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -18,28 +18,102 @@
 
     Notes:
     - All arguments and their attributes (e.g., description, type) are stored in dynamically allocated structures.
+    - Option values point into `argv` (or into a response or config file read into memory), they are never copied.
     - Users are responsible for invoking `eloArgFree()` to release all allocated resources after use.
     - The library is designed to integrate seamlessly with other C codebases, leveraging `HashTable` for argument management.
+    - C++ programs can use `eloarg.hpp`, typed accessors over `constexpr` option tables (C++17).
 
     Functions:
     - Initialization:
         - `eloArgInit`: Creates and initializes a new `EloArg` instance with a specified hash table size.
     - Option Definition:
         - `add`: Registers a new command-line argument with its short and long options, description, and value type.
+          Returns an `EloArgId` handle indexing the dense option array.
+        - `addTable`: Registers a static `EloArgSpec` table in one allocation, the strings are used in place.
+          The hash table is sized once for the whole table, each name is indexed and checked in one probe.
+          `ELOARG_OPTION_IDS` and `ELOARG_OPTION_TABLE` expand an X-macro option list to the enum of ids and the table.
+        - `setResolver`: Replaces the hash table lookup of long options while scanning with a generated matcher
+          (see tools/eloarg-gen.c). Names it doesn't know fall back to the hash table.
+        - `setHelp`: Gives `help` the precomputed lines of a range of options, e.g. the ones eloarg-gen writes.
+    - Binding:
+        - `bind`: Binds an option to a variable, `parse` converts and writes its value there as the option is met.
+        - `bindStruct`: Binds a table of `EloArgBinding` descriptors to the fields (`offsetof`) of a user struct.
     - Parsing:
         - `parse`: Processes `argc` and `argv` to identify and store user-provided options.
+        - `parseParallel`: Same as `parse`, for argv arrays in the millions. The arguments are split in chunks
+          scanned on a thread pool, then the results are stored in argv order. Small argv are parsed serially.
+        - `envPrefix`: Lets options fall back to environment variables named after the prefix and the long option
+          (`APP_` + `--dry-run` -> `APP_DRY_RUN`). `environ` is scanned once per parse, the command line takes precedence.
+        - `loadConfig`: Loads 'key = value' settings (INI sections allowed) from a config file read into an owned buffer.
+        - `watchConfig`: Starts a thread watching the config file with inotify. On change the file is read again
+          and every key whose value changed is reported to the change callback, the options themselves are untouched.
+        - `setDefault`: Sets the default value of an option.
+          Sources rank defaults < config file < environment < command line, whatever the call order.
+        - `responseFiles`: Enables '@file' arguments, replaced by the arguments listed in the file. The file is
+          read into memory and tokenized in place (shell-style quoting), arguments point into the buffer.
+          Response files may include other response files, tokenized files are cached by path, inode, size and mtime.
+        - `stream`: Walks `argc` and `argv` like `parse`, but hands every option and positional argument to callbacks
+          in argv order instead of storing them. Uses constant memory and doesn't allocate.
+        - `parseFd`: Reads NUL- or newline-delimited arguments from a file descriptor in fixed-size chunks (xargs -0),
+          stores the options like `parse` and hands the positional arguments to a callback.
+        - `parseBuffer`: Matches a NUL-separated command line (e.g. /proc/<pid>/cmdline) against the options
+          into a caller-provided `EloArgMatch` array, without modifying the buffer, allocating or exiting.
+        - `publish`: Parses `argc` and `argv` into an immutable `EloArgSnapshot` and swaps it in with one atomic
+          store, for reparsing while other threads read. Returns false without exiting on invalid arguments.
     - Retrieval:
         - `has`: Checks whether a specific option was provided by the user.
         - `get`: Retrieves the value associated with a specific option.
+        - `positionals`: Returns the non-option arguments in order, as pointers into `argv`.
+        - `rest`: Returns the arguments after `--`, a slice of `argv` itself.
+        - `events`: Returns every parsed option and positional argument in argv order.
+        - `hasId`, `getId`, `countId`: Same as `has`, `get` and `getCount`, but take the handle returned
+          by `add` and resolve the option with a plain array load instead of a hash table lookup.
+        - `idOf`: Returns the handle of an option from its short or long name.
+        - `anyProvided`, `allProvided`, `countProvided`: Check a bitset of option handles (`ELOARG_MASK_SET`)
+          against the provided options a 64-bit word at a time, for mutual exclusion and dependency rules.
+        - `acquire`, `release`: Pin the current snapshot and unpin it. Readers never lock or wait,
+          `publish` frees the previous snapshot once the readers holding it have released it.
+        - `getInt64`, `getUint64`, `getDouble`, `getBool`, `getSize`, `getDuration`: Typed getters, the value is
+          converted once with a locale-free parser and cached inside the option.
+    - Typing:
+        - `setType`: Declares the type of an option so its values are converted and validated during `parse`.
+    - Runtime Values:
+        - `setRuntime`: Converts a new value for a typed option once and publishes it to its atomic cell,
+          for flags changed by an admin thread while the program runs.
+        - `getRuntime`, `runtimeCell`: Read the cell with one acquire load. Hot paths keep the cell pointer
+          and read it with `eloArgLoadCell`.
+    - Bulk Conversion:
+        - `convertAll`: Converts every positional argument, or every value of a repeated option, into a typed array
+          (integers, doubles, sizes, durations or normalized paths) on the thread pool, reporting the invalid ones.
+        - `freeArray`: Releases an array filled by `convertAll`.
+    - Overlays:
+        - `overlaySet`: Overrides an option in a stack-allocated `EloArgOverlay` (up to 8 options), for settings
+          changed by a single request. Creating and dropping an overlay doesn't allocate.
+        - `overlayGet`, `overlayValue`: Read the string or typed value through the overlay, falling through
+          to the parsed options when the option isn't overridden.
     - Help:
         - `help`: Displays a user-friendly help message with descriptions of all defined options.
     - Cleanup:
         - `free`: Releases all allocated resources for the `EloArg` instance.
 */
 
+#define _GNU_SOURCE // strtod_l
+
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
+#include <errno.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <ctype.h>
+#include <limits.h>
+#include <locale.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/inotify.h>
 
 #include "eloarg.h"
 
@@ -48,7 +122,10 @@
 #define HELP_OPTION_LINE_LENGTH 46
 #define HELP_MAX_DESCRIPTION_SENTENCE_LENGTH 70
 
+extern char **environ;
+
 static EloArg eloarg;
+static pthread_mutex_t fileBufferMutex = PTHREAD_MUTEX_INITIALIZER;
 
 static void error(const char *formatStr, ...) {
     va_list args;
@@ -68,16 +145,446 @@ static void memAllocError(const char *detail) {
     error("Cannot allocate memory for '%s'.", detail);
 }
 
-static void freeEloArgOption(EloArgOption *option) {
-    if(!option)
+static bool takesValue(const EloArgOption *option) {
+    return option->valueType == ARG_OPTIONAL || option->valueType == ARG_REQUIRED;
+}
+
+static void invalidValueError(EloArgOption *option, const char *value) {
+    if(*option->longOption)
+        error("Invalid value '%s' for option: --%s", value, option->longOption);
+    else
+        error("Invalid value '%s' for option: -%s", value, option->shortOption);
+}
+
+// Parse an unsigned decimal integer, advancing the cursor past its digits
+static bool parseDigits(const char **cursor, uint64_t *out) {
+    const char *str = *cursor;
+    uint64_t value = 0;
+
+    if(*str < '0' || *str > '9')
+        return false;
+
+    while(*str >= '0' && *str <= '9') {
+        uint64_t digit = *str - '0';
+
+        if(value > (UINT64_MAX - digit) / 10)
+            return false; // Overflow
+
+        value = value * 10 + digit;
+        str++;
+    }
+
+    *cursor = str;
+    *out = value;
+
+    return true;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// Eight ASCII digits loaded in a 64-bit word, first digit in the low byte
+static bool isEightDigits(uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+// Combine the digits pairwise, then by four, then by eight (SWAR)
+static uint64_t parseEightDigits(uint64_t chunk) {
+    chunk -= 0x3030303030303030;
+    chunk = chunk * 10 + (chunk >> 8);
+
+    return (((chunk & 0x000000FF000000FF) * 0x000F424000000064) + (((chunk >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >> 32;
+}
+#endif
+
+// Parse a string made of 1 to 19 digits (never overflows) eight at a time, false sends the caller to parseDigits
+static bool parseDigitsSwar(const char *str, size_t length, uint64_t *out) {
+    uint64_t value = 0;
+
+    if(length == 0 || length > 19)
+        return false;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for(uint64_t chunk; length >= 8; str += 8, length -= 8) {
+        memcpy(&chunk, str, sizeof(chunk));
+
+        if(!isEightDigits(chunk))
+            return false;
+
+        value = value * 100000000 + parseEightDigits(chunk);
+    }
+#endif
+
+    for(; length > 0; str++, length--) {
+        if(*str < '0' || *str > '9')
+            return false;
+
+        value = value * 10 + (*str - '0');
+    }
+
+    *out = value;
+
+    return true;
+}
+
+// Parse the digits after a decimal point as a fraction of one
+static double parseFraction(const char **cursor) {
+    const char *str = *cursor;
+    double fraction = 0, scale = 0.1;
+
+    while(*str >= '0' && *str <= '9') {
+        fraction += (*str - '0') * scale;
+        scale /= 10;
+        str++;
+    }
+
+    *cursor = str;
+
+    return fraction;
+}
+
+static bool convertInt64(const char *str, int64_t *out) {
+    bool negative = *str == '-';
+    uint64_t magnitude;
+
+    if(*str == '-' || *str == '+')
+        str++;
+
+    if(!parseDigits(&str, &magnitude) || *str != '\0')
+        return false;
+
+    if(negative) {
+        if(magnitude > (uint64_t)INT64_MAX + 1)
+            return false;
+
+        *out = magnitude == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -(int64_t)magnitude;
+    }
+    else {
+        if(magnitude > INT64_MAX)
+            return false;
+
+        *out = (int64_t)magnitude;
+    }
+
+    return true;
+}
+
+static bool convertUint64(const char *str, uint64_t *out) {
+    if(*str == '+')
+        str++;
+
+    return parseDigits(&str, out) && *str == '\0';
+}
+
+static locale_t cLocale;
+static pthread_once_t cLocaleOnce = PTHREAD_ONCE_INIT;
+
+static void createCLocale() {
+    cLocale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+}
+
+// Decimal floating point without the locale dependency of strtod.
+// Values with up to 19 significant digits and a small exponent are exact (Clinger's fast path),
+// anything else is handed over to strtod_l in the "C" locale, whatever setlocale chose.
+static bool convertDouble(const char *str, double *out) {
+    static const double powersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char *cursor = str;
+    bool negative = *cursor == '-';
+    uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool anyDigit = false, truncated = false;
+
+    if(*cursor == '-' || *cursor == '+')
+        cursor++;
+
+    for(; *cursor >= '0' && *cursor <= '9'; cursor++, anyDigit = true) {
+        if(digits < 19) {
+            mantissa = mantissa * 10 + (*cursor - '0');
+            digits += mantissa > 0;
+        }
+        else {
+            exponent++;
+            truncated |= *cursor != '0';
+        }
+    }
+
+    if(*cursor == '.')
+        for(cursor++; *cursor >= '0' && *cursor <= '9'; cursor++, anyDigit = true) {
+            if(digits < 19) {
+                mantissa = mantissa * 10 + (*cursor - '0');
+                digits += mantissa > 0;
+                exponent--;
+            }
+            else
+                truncated |= *cursor != '0';
+        }
+
+    if(!anyDigit)
+        return false;
+
+    if(*cursor == 'e' || *cursor == 'E') {
+        bool negativeExponent = *++cursor == '-';
+        uint64_t value;
+
+        if(*cursor == '-' || *cursor == '+')
+            cursor++;
+
+        if(!parseDigits(&cursor, &value))
+            return false;
+
+        value = value > 9999 ? 9999 : value;
+        exponent += negativeExponent ? -(int)value : (int)value;
+    }
+
+    if(*cursor != '\0')
+        return false;
+
+    if(!truncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double value = (double)mantissa;
+        value = exponent < 0 ? value / powersOfTen[-exponent] : value * powersOfTen[exponent];
+        *out = negative ? -value : value;
+
+        return true;
+    }
+
+    pthread_once(&cLocaleOnce, createCLocale);
+
+    if(!cLocale)
+        return false;
+
+    char *end;
+    errno = 0;
+    *out = strtod_l(str, &end, cLocale);
+
+    return *end == '\0' && errno != ERANGE;
+}
+
+static bool convertBool(const char *str, bool *out) {
+    static const char *truthy[] = { "1", "true", "yes", "on" };
+    static const char *falsy[] = { "0", "false", "no", "off" };
+
+    for(size_t i = 0; i < sizeof(truthy) / sizeof(*truthy); i++) {
+        if(strcasecmp(str, truthy[i]) == 0) {
+            *out = true;
+            return true;
+        }
+        else if(strcasecmp(str, falsy[i]) == 0) {
+            *out = false;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Byte sizes: 512, 4K, 4KiB, 1.5GiB (binary multiples) and 4KB, 2MB (decimal multiples).
+// A fraction must come to a whole number of bytes, 1.5B and 0.1K are rejected.
+static bool convertSize(const char *str, uint64_t *out) {
+    static const struct {
+        const char *suffix;
+        uint64_t multiplier;
+    } units[] = {
+        { "", 1 }, { "B", 1 },
+        { "K", 1ULL << 10 }, { "k", 1ULL << 10 }, { "KiB", 1ULL << 10 }, { "KB", 1000ULL }, { "kB", 1000ULL },
+        { "M", 1ULL << 20 }, { "MiB", 1ULL << 20 }, { "MB", 1000000ULL },
+        { "G", 1ULL << 30 }, { "GiB", 1ULL << 30 }, { "GB", 1000000000ULL },
+        { "T", 1ULL << 40 }, { "TiB", 1ULL << 40 }, { "TB", 1000000000000ULL },
+        { "P", 1ULL << 50 }, { "PiB", 1ULL << 50 }, { "PB", 1000000000000000ULL },
+        { "E", 1ULL << 60 }, { "EiB", 1ULL << 60 }, { "EB", 1000000000000000000ULL }
+    };
+    uint64_t whole, bytes, numerator = 0, denominator = 1;
+
+    if(!parseDigits(&str, &whole))
+        return false;
+
+    // The fraction is kept exact as numerator / denominator, up to 18 digits
+    if(*str == '.')
+        for(str++; *str >= '0' && *str <= '9'; str++) {
+            if(denominator <= UINT64_MAX / 10 / 10) {
+                numerator = numerator * 10 + (*str - '0');
+                denominator *= 10;
+            }
+            else if(*str != '0')
+                return false;
+        }
+
+    for(size_t i = 0; i < sizeof(units) / sizeof(*units); i++) {
+        if(strcmp(str, units[i].suffix) != 0)
+            continue;
+
+        unsigned __int128 fraction = (unsigned __int128)numerator * units[i].multiplier;
+
+        if(fraction % denominator != 0 ||
+           __builtin_mul_overflow(whole, units[i].multiplier, &bytes) ||
+           __builtin_add_overflow(bytes, (uint64_t)(fraction / denominator), &bytes))
+            return false;
+
+        *out = bytes;
+        return true;
+    }
+
+    return false;
+}
+
+// Durations in nanoseconds: 30s, 250ms, 1h30m, 1.5d. A bare number is in seconds.
+static bool convertDuration(const char *str, uint64_t *out) {
+    static const struct {
+        const char *suffix;
+        uint64_t nanoseconds;
+    } units[] = {
+        { "ns", 1ULL }, { "us", 1000ULL }, { "ms", 1000000ULL }, { "s", 1000000000ULL },
+        { "m", 60000000000ULL }, { "h", 3600000000000ULL }, { "d", 86400000000000ULL }
+    };
+    uint64_t total = 0;
+    bool first = true;
+
+    do {
+        uint64_t whole, nanoseconds;
+        double fraction = 0;
+        size_t unit, suffixLength = 0;
+
+        if(!parseDigits(&str, &whole))
+            return false;
+
+        if(*str == '.')
+            str++, fraction = parseFraction(&str);
+
+        while((str[suffixLength] >= 'a' && str[suffixLength] <= 'z'))
+            suffixLength++;
+
+        if(suffixLength == 0 && first && *str == '\0')
+            unit = 3; // Seconds
+        else {
+            for(unit = 0; unit < sizeof(units) / sizeof(*units); unit++)
+                if(strlen(units[unit].suffix) == suffixLength && strncmp(str, units[unit].suffix, suffixLength) == 0)
+                    break;
+
+            if(unit == sizeof(units) / sizeof(*units))
+                return false;
+        }
+
+        if(__builtin_mul_overflow(whole, units[unit].nanoseconds, &nanoseconds) ||
+           __builtin_add_overflow(nanoseconds, (uint64_t)(fraction * units[unit].nanoseconds), &nanoseconds) ||
+           __builtin_add_overflow(total, nanoseconds, &total))
+            return false;
+
+        str += suffixLength;
+        first = false;
+    } while(*str != '\0');
+
+    *out = total;
+
+    return true;
+}
+
+static bool convertValue(const char *str, ArgDataType type, EloArgValue *out) {
+    switch(type) {
+        case ARG_TYPE_INT64:
+            return convertInt64(str, &out->i64);
+        case ARG_TYPE_UINT64:
+            return convertUint64(str, &out->u64);
+        case ARG_TYPE_DOUBLE:
+            return convertDouble(str, &out->f64);
+        case ARG_TYPE_BOOL:
+            return convertBool(str, &out->boolean);
+        case ARG_TYPE_SIZE:
+            return convertSize(str, &out->u64);
+        case ARG_TYPE_DURATION:
+            return convertDuration(str, &out->u64);
+        default:
+            return false;
+    }
+}
+
+// Convert the option value to the given type, caching the result inside the option
+static EloArgValue typedValue(EloArgOption *option, ArgDataType type) {
+    if(option->cached && option->cacheType == type)
+        return option->cache;
+
+    EloArgValue value = { 0 };
+
+    if(!option->value)
+        value.boolean = type == ARG_TYPE_BOOL && option->provided; // Flags without a value
+    else if(!convertValue(option->value, type, &value))
+        invalidValueError(option, option->value);
+
+    option->cache = value;
+    option->cacheType = type;
+    option->cached = true;
+
+    return value;
+}
+
+static void publishRuntime(EloArgOption *option, EloArgValue value) {
+    __atomic_store_n(&option->runtime.bits, value.u64, __ATOMIC_RELEASE);
+}
+
+// Write the current state of the option into its bound storage
+static void writeBinding(EloArgOption *option) {
+    if(!option->binding)
         return;
 
-    option->refCount--;
+    switch(option->bindType) {
+        case ARG_TYPE_STRING:
+        case ARG_TYPE_PATH:
+            *(const char **)option->binding = option->value;
+            break;
+        case ARG_TYPE_COUNT:
+            *(size_t *)option->binding = option->count;
+            break;
+        case ARG_TYPE_BOOL:
+            *(bool *)option->binding = typedValue(option, ARG_TYPE_BOOL).boolean;
+            break;
+        case ARG_TYPE_INT64:
+            *(int64_t *)option->binding = typedValue(option, ARG_TYPE_INT64).i64;
+            break;
+        case ARG_TYPE_DOUBLE:
+            *(double *)option->binding = typedValue(option, ARG_TYPE_DOUBLE).f64;
+            break;
+        case ARG_TYPE_UINT64:
+        case ARG_TYPE_SIZE:
+        case ARG_TYPE_DURATION:
+            *(uint64_t *)option->binding = typedValue(option, option->bindType).u64;
+            break;
+    }
+}
+
+static void setProvided(EloArgOption *option, bool provided) {
+    option->provided = provided;
+
+    if(provided)
+        ELOARG_MASK_SET(eloarg.providedMask, option->id);
+    else
+        eloarg.providedMask[option->id / 64] &= ~(UINT64_C(1) << (option->id % 64));
+}
+
+// Record one occurrence of the option, with or without a value.
+// Sources rank defaults < config file < environment < command line, a higher source resets the option.
+static void storeOption(EloArgOption *option, const char *value, ArgSource source) {
+    if(source < option->source)
+        return;
+    else if(source > option->source) {
+        option->source = source;
+        option->count = 0;
+    }
 
-    if(option->refCount == 0) {
-        FREE(option->value);
-        FREE(option);
+    // Defaults set the value without marking the option as provided
+    if(source != ARG_SOURCE_DEFAULT) {
+        setProvided(option, true);
+        option->count++;
     }
+
+    option->cached = false;
+
+    if(value)
+        option->value = value; // The option may be repeated, the last value wins
+
+    // Convert typed options while parsing so errors are reported right away
+    if(option->dataType != ARG_TYPE_STRING)
+        publishRuntime(option, typedValue(option, option->dataType));
+
+    writeBinding(option);
 }
 
 static void printDescription(const char *description) {
@@ -85,8 +592,10 @@ static void printDescription(const char *description) {
     const char *wordStart = description;
 
     while(*description != '\0') {
-        if(*description == ' ' || *description == '\t' || *(description + 1) == '\0') {
-            int wordLen = description - wordStart;
+        bool blank = *description == ' ' || *description == '\t';
+
+        if(blank || *(description + 1) == '\0') {
+            int wordLen = description - wordStart + !blank; // The last word ends with the string
 
             if(length + wordLen + (length > 0) <= HELP_MAX_DESCRIPTION_SENTENCE_LENGTH) {
                 if(length > 0)
@@ -111,288 +620,2420 @@ static void printDescription(const char *description) {
 }
 
 static void printHelp(const char *description, const char *footerDescription) {
-    HashTable *hashTable = eloarg.hashTable;
-
-    if(hashTable->count(hashTable) == 0)
+    if(eloarg.count == 0)
         return;
 
-    HashTable *exist = initHashTable(eloarg.count * 2);
-
     if(description)
         puts(description);
 
     puts("Options:");
 
-    for (size_t i = 0; i < hashTable->getSize(hashTable); i++) {
-        if(hashTable->table[i] && hashTable->table[i]->occupied) {
-            EloArgOption *option = hashTable->table[i]->value;
+    // In registration order
+    for(uint32_t i = 0; i < eloarg.count; i++) {
+        const EloArgOption *option = eloarg.options[i];
 
-            if(exist->has(exist, option->uniqueStrId))
-                continue;
-            else
-                exist->set(exist, option->uniqueStrId, "true");
-
-            if(*option->shortOption && *option->longOption) {
-                printf("  -%s, --%s%-*s",
-                        option->shortOption,
-                        option->longOption,
-                        HELP_PADDING_RIGHT - (int)strlen(option->longOption),
-                        "");
-                printDescription(option->description);
-            }
-            else if(*option->shortOption) {
-                printf("  -%s%-*s", 
-                        option->shortOption,
-                        HELP_PADDING_RIGHT,
-                        "");
-                printDescription(option->description);
-            }
-            else if(*option->longOption) {
-                printf("      --%s%-*s",
-                        option->longOption,
-                        HELP_PADDING_RIGHT - (int)strlen(option->longOption),
-                        "");
-                printDescription(option->description);
-            }
+        if(eloarg.helpLines && i == eloarg.helpFirst) {
+            fputs(eloarg.helpLines, stdout);
+            i += eloarg.helpCount - 1;
+        }
+        else if(*option->shortOption && *option->longOption) {
+            printf("  -%s, --%s%-*s",
+                    option->shortOption,
+                    option->longOption,
+                    HELP_PADDING_RIGHT - (int)strlen(option->longOption),
+                    "");
+            printDescription(option->description);
+        }
+        else if(*option->shortOption) {
+            printf("  -%s%-*s", 
+                    option->shortOption,
+                    HELP_PADDING_RIGHT,
+                    "");
+            printDescription(option->description);
+        }
+        else if(*option->longOption) {
+            printf("      --%s%-*s",
+                    option->longOption,
+                    HELP_PADDING_RIGHT - (int)strlen(option->longOption),
+                    "");
+            printDescription(option->description);
         }
     }
 
     if(footerDescription)
         printf("\n%s\n", footerDescription);
 
-    exist->free(&exist);
     eloArgFree();
     exit(EXIT_SUCCESS);
 }
 
-static void eloArgAdd(char *shortOption, char *longOption, char *description, ArgValueType valueType) {
-    if(!shortOption && !longOption)
-        error("You must enter either the short or long option.");
-    else if(!description)
-        error("You must set the description for option '%s'.", longOption ? longOption : shortOption);
+// The bitsets grow with the option array, the new words start cleared
+static bool growOptionMasks(size_t capacity, size_t newCapacity) {
+    size_t words = ELOARG_MASK_WORDS(capacity), newWords = ELOARG_MASK_WORDS(newCapacity);
+    uint64_t **masks[] = { &eloarg.providedMask, &eloarg.requiredMask, &eloarg.defaultMask };
 
-    HashTable *hashTable = eloarg.hashTable;
+    for(size_t i = 0; i < sizeof(masks) / sizeof(*masks) && newWords > words; i++) {
+        uint64_t *mask = realloc(*masks[i], newWords * sizeof(uint64_t));
 
-    if(hashTable->has(hashTable, shortOption))
-        error("You've already set the short option '%s'.", shortOption);
-    else if(hashTable->has(hashTable, longOption))
-        error("You've already set the long option '%s'.", longOption);
+        if(!mask)
+            return false;
 
-    EloArgOption *option = malloc(sizeof(EloArgOption));
+        memset(mask + words, 0, (newWords - words) * sizeof(uint64_t));
+        *masks[i] = mask;
+    }
 
-    if(!option)
-        memAllocError("EloArgOption");
+    return true;
+}
+
+static void checkOption(const char *shortOption, const char *longOption, const char *description) {
+    if(!shortOption && !longOption)
+        error("You must enter either the short or long option.");
+    else if(!description)
+        error("You must set the description for option '%s'.", longOption ? longOption : shortOption);
 
+    // Duplicates are caught by registerOption, in the probe that indexes the name
     if(shortOption && strlen(shortOption) > ELOARG_SHORT_OPTION_LENGTH)
         error("The maximum length of the short option is %u.", ELOARG_SHORT_OPTION_LENGTH);
     else if(longOption && strlen(longOption) > ELOARG_LONG_OPTION_LENGTH)
         error("The maximum length of the long option is %u.", ELOARG_LONG_OPTION_LENGTH);
     else if(strlen(description) > ELOARG_DESCRIPTION_LENGTH)
         error("The maximum length of the description is %u.", ELOARG_DESCRIPTION_LENGTH);
-        
-    *option->shortOption = '\0';
-    *option->longOption = '\0';
-    
-    strcpy(option->description, description);
-    option->valueType = valueType;
-    
-    snprintf(option->uniqueStrId, sizeof(option->uniqueStrId), "%u", eloarg.count);
+}
+
+// Grows the dense option array to hold 'count' more options
+static void reserveOptions(size_t count) {
+    if((size_t)eloarg.count + count <= eloarg.capacity)
+        return;
+    else if((size_t)eloarg.count + count >= ELOARG_INVALID_ID)
+        error("Too many options.");
+
+    uint32_t capacity = eloarg.capacity ? eloarg.capacity : 8;
+
+    while(capacity < eloarg.count + count)
+        capacity = capacity > UINT32_MAX / 2 ? ELOARG_INVALID_ID : capacity * 2;
+
+    EloArgOption **options = realloc(eloarg.options, capacity * sizeof(EloArgOption *));
 
+    if(!options)
+        memAllocError("EloArgOption array");
+
+    eloarg.options = options;
+
+    if(!growOptionMasks(eloarg.capacity, capacity))
+        memAllocError("option bitsets");
+
+    eloarg.capacity = capacity;
+}
+
+// Indexes an option whose strings are already in place, they are the hash table keys
+static EloArgId registerOption(EloArgOption *option, ArgValueType valueType) {
+    HashTable *hashTable = eloarg.hashTable;
+
+    option->valueType = valueType;
+    option->id = eloarg.count;
     option->value = NULL;
+    option->ownedValue = NULL;
+    option->binding = NULL;
+    option->bindType = ARG_TYPE_STRING;
+    option->dataType = ARG_TYPE_STRING;
+    option->cached = false;
+    option->source = ARG_SOURCE_NONE;
+    option->defaultValue = NULL;
     option->provided = false;
     option->count = 0;
-    option->refCount = 0; // Using a reference counter because two keys can share the same memory
+    option->runtime.bits = 0;
 
-    if(shortOption) {
-        strcpy(option->shortOption, shortOption);
-        option->refCount++;
-        hashTable->set(hashTable, shortOption, option);
-    }
+    bool shortTaken = *option->shortOption && !hashTable->insert(hashTable, option->shortOption, option);
+    bool longTaken = !shortTaken && *option->longOption && !hashTable->insert(hashTable, option->longOption, option);
+
+    // Registered even when a name is taken, so free releases it
+    eloarg.options[eloarg.count++] = option;
+
+    if(shortTaken)
+        error("You've already set the short option '%s'.", option->shortOption);
+    else if(longTaken)
+        error("You've already set the long option '%s'.", option->longOption);
+
+    if(*option->shortOption)
+        eloarg.shortOptions[(unsigned char)*option->shortOption] = option;
+
+    if(valueType == ARG_REQUIRED)
+        ELOARG_MASK_SET(eloarg.requiredMask, option->id);
+
+    return option->id;
+}
+
+static EloArgId eloArgAdd(char *shortOption, char *longOption, char *description, ArgValueType valueType) {
+    checkOption(shortOption, longOption, description);
+    reserveOptions(1);
+
+    size_t shortLength = shortOption ? strlen(shortOption) : 0;
+    size_t longLength = longOption ? strlen(longOption) : 0;
+    size_t descriptionLength = strlen(description);
+    EloArgOption *option;
+
+    // One block for the option and its strings, aligned for the runtime cell
+    if(posix_memalign((void **)&option, _Alignof(EloArgOption), sizeof(EloArgOption) + shortLength + longLength + descriptionLength + 3) != 0)
+        memAllocError("EloArgOption");
+
+    char *strings = (char *)(option + 1);
+
+    option->shortOption = memcpy(strings, shortLength ? shortOption : "", shortLength + 1);
+    strings += shortLength + 1;
+    option->longOption = memcpy(strings, longLength ? longOption : "", longLength + 1);
+    strings += longLength + 1;
+    option->description = memcpy(strings, description, descriptionLength + 1);
+    option->block = option;
+
+    return registerOption(option, valueType);
+}
+
+static EloArgId eloArgAddTable(const EloArgSpec *specs, size_t count) {
+    if(!specs || count == 0)
+        error("You must set the option table.");
+
+    reserveOptions(count);
+
+    EloArgOption *options;
+
+    // The strings stay in the table, one allocation for all the options
+    if(posix_memalign((void **)&options, _Alignof(EloArgOption), count * sizeof(EloArgOption)) != 0)
+        memAllocError("EloArgOption table");
+
+    EloArgId first = eloarg.count;
+
+    // Sized once for every name, each one is then indexed and checked for duplicates in a single probe
+    eloarg.hashTable->reserve(eloarg.hashTable, 2 * count);
+
+    for(size_t i = 0; i < count; i++) {
+        EloArgOption *option = &options[i];
+
+        checkOption(specs[i].shortOption, specs[i].longOption, specs[i].description);
 
-    if(longOption) {
-        strcpy(option->longOption, longOption);
-        option->refCount++;
-        hashTable->set(hashTable, longOption, option);
+        option->shortOption = specs[i].shortOption ? specs[i].shortOption : "";
+        option->longOption = specs[i].longOption ? specs[i].longOption : "";
+        option->description = specs[i].description;
+        option->block = options;
+
+        EloArgId id = registerOption(option, specs[i].valueType);
+
+        if(specs[i].dataType != ARG_TYPE_STRING)
+            eloArgSetType(id, specs[i].dataType);
     }
 
-    eloarg.count++;
+    return first;
 }
 
-static void eloArgParse(int argc, char **argv) {
-    HashTable *hashTable = eloarg.hashTable;
+static void eloArgSetResolver(EloArgResolver resolver) {
+    eloarg.resolver = resolver;
+}
 
-    if(argc == 0 || hashTable->count(hashTable) == 0)
-        return;
+// 'lines' must print exactly like the options it replaces, one or more lines each
+static void eloArgSetHelp(EloArgId first, size_t count, const char *lines) {
+    if(lines && (count == 0 || first >= eloarg.count || count > eloarg.count - first))
+        error("Cannot set the help of unknown option ids.");
 
-    // Loop through arguments
-    for(size_t i = 1; i < argc; i++) {
-        bool optionMatched = false;
+    eloarg.helpLines = lines;
+    eloarg.helpFirst = first;
+    eloarg.helpCount = count;
+}
 
-        // Terminate options parsing
-        if(strcmp(argv[i], "--") == 0)
-            return;
+static void eloArgBind(const char *key, ArgDataType type, void *destination) {
+    EloArgOption *option = (EloArgOption *)eloarg.hashTable->get(eloarg.hashTable, key);
 
-        // Check for the long option
-        if(argv[i][0] == '-' && argv[i][1] == '-') {
-            char *eqPos = strchr(argv[i], '=');
+    if(!option)
+        error("Cannot bind the unknown option '%s'.", key ? key : "(null)");
+    else if(!destination)
+        error("You must set the destination for option '%s'.", key);
 
-            // If '=' exists, split the option and the value
-            if(eqPos) {
-                *eqPos = '\0'; // Terminate the option part (--option= -> =)
-                EloArgOption *option = (EloArgOption *)hashTable->get(hashTable, argv[i] + 2); // Skip the '--'
+    if(!takesValue(option) && type != ARG_TYPE_BOOL && type != ARG_TYPE_COUNT)
+        error("Option '%s' doesn't take a value, bind it as ARG_TYPE_BOOL or ARG_TYPE_COUNT.", key);
+    else if(type == ARG_TYPE_PATH)
+        error("Option '%s' cannot be bound as ARG_TYPE_PATH, which is only converted by convertAll.", key);
 
-                if(!option)
-                    error("Unknown option: %s.\nUse option '--help' for more information.", argv[i]);
+    option->binding = destination;
+    option->bindType = type;
+}
 
-                if(option->valueType == ARG_OPTIONAL || option->valueType == ARG_REQUIRED) {
-                    if(*(eqPos + 1) == '\0')
-                        error("Missing value for option: --%s=", option->longOption);
+static void eloArgSetType(EloArgId id, ArgDataType type) {
+    if(id >= eloarg.count)
+        error("Cannot set the type of the unknown option id %u.", id);
 
-                    option->provided = true;
-                    option->value = strdup(eqPos + 1); // Value after '='
-                    option->count++;
+    EloArgOption *option = eloarg.options[id];
+    if(type == ARG_TYPE_COUNT || type == ARG_TYPE_PATH || (!takesValue(option) && type != ARG_TYPE_BOOL && type != ARG_TYPE_STRING))
+        error("Option '%s' cannot be converted to this type.", *option->longOption ? option->longOption : option->shortOption);
 
-                    if(!option->value)
-                        memAllocError("EloArgOption value");
-                }
-                else
-                    error("option '--%s' doesn't allow an argument.", option->longOption);
+    option->dataType = type;
+}
 
-                optionMatched = true;
-            }
-            else { // Long option with space
-                EloArgOption *option = (EloArgOption *)hashTable->get(hashTable, argv[i] + 2);
-
-                if(!option)
-                    error("Unknown option: %s.\nUse option '--help' for more information.", argv[i]);
-
-                option->provided = true;
-                option->count++;
-                optionMatched = true;
-
-                // Return if the valueType is ARG_INFO (for --help and --version etc.)
-                if(option->valueType == ARG_INFO)
-                    return;
-                else if(option->valueType == ARG_OPTIONAL || option->valueType == ARG_REQUIRED) { // Handle argument for options that require a value
-                    if(i + 1 < argc && argv[i + 1][0] != '-') {
-                        option->value = strdup(argv[i + 1]);
-
-                        if(!option->value)
-                            memAllocError("EloArgOption value");
-
-                        i++; // Skip the value argument
-                    }
-                    else
-                        error("Missing value for option: --%s", option->longOption);
-                }
-            }
+static EloArgId eloArgIdOf(const char *key) {
+    EloArgOption *option = (EloArgOption *)eloarg.hashTable->get(eloarg.hashTable, key);
+
+    return option ? option->id : ELOARG_INVALID_ID;
+}
+
+static void eloArgBindStruct(void *base, const EloArgBinding *bindings, size_t count) {
+    if(!base)
+        error("You must set the struct to bind the options to.");
+
+    for(size_t i = 0; i < count; i++)
+        eloArgBind(bindings[i].key, bindings[i].type, (char *)base + bindings[i].offset);
+}
+
+static void argVectorPush(ArgVector *vector, char *argument) {
+    if(vector->count == vector->capacity) {
+        size_t capacity = vector->capacity ? vector->capacity * 2 : 64;
+        char **items = realloc(vector->items, capacity * sizeof(char *));
+
+        if(!items) {
+            FREE(vector->items);
+            memAllocError("argument vector");
         }
 
-        // Check for combined short options
-        if(!optionMatched && argv[i][0] == '-') {
-            char *opt = argv[i] + 1; // Skip the '-'
-            char tmpOpt[2] = { *opt, '\0' };
+        vector->items = items;
+        vector->capacity = capacity;
+    }
+
+    vector->items[vector->count++] = argument;
+}
+
+// Read a whole file into a heap buffer with a zero byte past the end. Values point into the buffer,
+// which unlike a file mapping stays valid when the file is truncated or rewritten afterwards.
+// 'status' receives the status of the file actually read, when not NULL.
+static char *readFile(const char *path, size_t *size, struct stat *status) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat st;
 
-            while(*opt) {
-                EloArgOption *option = (EloArgOption *)hashTable->get(hashTable, tmpOpt);
+    if(fd < 0 || fstat(fd, &st) < 0) {
+        if(fd >= 0)
+            close(fd);
 
-                if(!option)
-                    error("Unknown option '%c'.\nUse option '--help' for more information.", *opt);
+        return NULL;
+    }
 
-                option->provided = true;
-                option->count++;
-                optionMatched = true;
+    size_t capacity = (size_t)st.st_size + 1, length = 0; // One more byte to see the end of the file right away
+    char *data = malloc(capacity + 1);
 
-                if(option->valueType == ARG_INFO)
-                    return;
-                else if(option->valueType == ARG_OPTIONAL || option->valueType == ARG_REQUIRED) {
-                    if(*(opt + 1) != '\0') { // -p443
-                        option->value = strdup(opt + 1);
+    while(data) {
+        if(length == capacity) { // Grew since fstat
+            char *grown = realloc(data, capacity * 2 + 1);
 
-                        if(!option->value)
-                            memAllocError("EloArgOption value");
+            if(!grown)
+                break;
 
-                        break;
-                    }
-                    else if(i + 1 < argc && argv[i + 1][0] != '-') { // -p 443
-                        option->value = strdup(argv[i + 1]);
+            data = grown;
+            capacity *= 2;
+        }
 
-                        if(!option->value)
-                            memAllocError("EloArgOption value");
+        ssize_t count = read(fd, data + length, capacity - length);
 
-                        i++; // Skip the value argument
-                    }
-                    else
-                        error("Missing value for option: -%c", *opt);
-                }
+        if(count < 0 && errno == EINTR)
+            continue;
+        else if(count <= 0) {
+            close(fd);
 
-                opt++;
+            if(count < 0) {
+                FREE(data);
+                return NULL;
             }
+
+            data[length] = '\0';
+            *size = length;
+
+            if(status)
+                *status = st;
+
+            return data;
         }
+
+        length += count;
     }
 
-    // Check for missing required arguments
-    for(size_t i = 0; i < hashTable->getSize(hashTable); i++) {
-        if(hashTable->table[i] && hashTable->table[i]->occupied) {
-            EloArgOption *option = (EloArgOption *)hashTable->table[i]->value;
+    FREE(data);
+    close(fd);
 
-            if(option->valueType == ARG_REQUIRED && option->value == NULL) {
-                if(*option->longOption)
-                    error("Missing required option: '--%s'\nUse option '--help' for more information.", option->longOption);
-                else
-                    error("Missing required option: '-%s'\nUse option '--help' for more information.", option->shortOption);
-            }
+    return NULL;
+}
+
+// Keep a buffer read by readFile until free, option values point into it
+static bool keepFileBuffer(char *data) {
+    bool kept = true;
+
+    // The config watcher thread reads files too
+    pthread_mutex_lock(&fileBufferMutex);
+
+    if(eloarg.fileBuffers.count == eloarg.fileBuffers.capacity) {
+        size_t capacity = eloarg.fileBuffers.capacity ? eloarg.fileBuffers.capacity * 2 : 4;
+        char **items = realloc(eloarg.fileBuffers.items, capacity * sizeof(char *));
+
+        if(items) {
+            eloarg.fileBuffers.items = items;
+            eloarg.fileBuffers.capacity = capacity;
         }
+        else
+            kept = false;
     }
-}
 
-static bool eloArgHas(const char *key) {
-    EloArgOption *option = (EloArgOption *)eloarg.hashTable->get(eloarg.hashTable, key);
-    
-    return option && option->provided;
-}
+    if(kept)
+        eloarg.fileBuffers.items[eloarg.fileBuffers.count++] = data;
 
-static const char *eloArgGet(const char *key) {
-    EloArgOption *option = (EloArgOption *)eloarg.hashTable->get(eloarg.hashTable, key);
+    pthread_mutex_unlock(&fileBufferMutex);
 
-    return option && option->provided ? option->value : NULL;
+    return kept;
 }
 
-static size_t eloArgCount(const char *key) {
-    EloArgOption *option = (EloArgOption *)eloarg.hashTable->get(eloarg.hashTable, key);
-
-    return option && option->provided ? option->count : 0;
+static bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
 }
 
-static void eloArgFree() {
-    if(!eloarg.hashTable)
-        return;
+// Split a response file buffer into arguments in place: quotes are removed and every
+// token is NUL-terminated where it lies, nothing is copied.
+static void tokenizeResponseFile(char *data, size_t size, ArgVector *arguments) {
+    char *cursor = data, *end = data + size;
 
-    EloArgOption *option;
-    HashTable *hashTable = eloarg.hashTable;
+    while(cursor < end) {
+        while(cursor < end && isBlank(*cursor))
+            cursor++;
+
+        if(cursor == end)
+            break;
+
+        char *token = cursor, *out = cursor;
+        char quote = '\0';
+
+        // Quote removal only shrinks the token, so 'out' never passes 'cursor'
+        while(cursor < end) {
+            char c = *cursor;
 
-    // Free the EloArgOptions
-    if(hashTable->count(hashTable) > 0)
-        for(size_t i = 0; i < hashTable->getSize(hashTable); i++)
-            if(hashTable->table[i] && hashTable->table[i]->occupied) {
-                option = (EloArgOption *)hashTable->table[i]->value;
-                
-                hashTable->table[i]->value = NULL;
-                freeEloArgOption(option);
+            if(quote) {
+                if(c == quote) {
+                    quote = '\0';
+                    cursor++;
+                    continue;
+                }
+                else if(c == '\\' && quote == '"' && cursor + 1 < end && (cursor[1] == '"' || cursor[1] == '\\'))
+                    c = *++cursor;
+            }
+            else if(isBlank(c))
+                break;
+            else if(c == '\'' || c == '"') {
+                quote = c;
+                cursor++;
+                continue;
             }
+            else if(c == '\\' && cursor + 1 < end)
+                c = *++cursor;
 
-    eloarg.hashTable->free(&eloarg.hashTable);
+            *out++ = c;
+            cursor++;
+        }
+
+        *out = '\0'; // At worst the zero byte readFile put past the end
+        cursor++;
+
+        argVectorPush(arguments, token);
+    }
+}
+
+// Tokenized response file, cached for the lifetime of the process. A file replaced under the same
+// path gets a new inode, one rewritten within the mtime granularity most likely a new size.
+typedef struct {
+    char *path;
+    dev_t device;
+    ino_t inode;
+    struct timespec mtime;
+    off_t size;
+    ArgVector tokens; // Point into the file buffer
+    uint32_t checkedGeneration; // Parse in which the file status was last checked
+    bool expanding; // Being expanded, used to detect include cycles
+} ResponseFile;
+
+static bool isResponseFileArgument(const char *argument) {
+    return argument[0] == '@' && argument[1] != '\0';
+}
+
+// Ask the kernel to start reading a file we're about to need
+static void prefetchResponseFile(const char *path) {
+    if(eloarg.responseCache->has(eloarg.responseCache, path))
+        return;
+
+    int fd = open(path, O_RDONLY);
+
+    if(fd < 0)
+        return; // Reported when the file is actually read
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+}
+
+static void freeResponseFile(ResponseFile *file) {
+    FREE(file->path);
+    FREE(file->tokens.items);
+    FREE(file);
+}
+
+static ResponseFile *loadResponseFile(const char *path) {
+    HashTable *cache = eloarg.responseCache;
+    ResponseFile *file = (ResponseFile *)cache->get(cache, path);
+    struct stat st;
+
+    // Check the file once per parse, the same file is often included many times
+    if(file && file->checkedGeneration == eloarg.parseGeneration)
+        return file;
+
+    if(stat(path, &st) < 0)
+        error("Cannot read the response file '%s'.", path);
+
+    if(file && file->device == st.st_dev && file->inode == st.st_ino && file->size == st.st_size &&
+       file->mtime.tv_sec == st.st_mtim.tv_sec && file->mtime.tv_nsec == st.st_mtim.tv_nsec) {
+        file->checkedGeneration = eloarg.parseGeneration;
+        return file;
+    }
+
+    size_t size;
+    char *data = readFile(path, &size, &st);
+
+    if(!data)
+        error("Cannot read the response file '%s'.", path);
+    else if(!keepFileBuffer(data)) {
+        FREE(data);
+        memAllocError("response file");
+    }
+
+    if(!file) {
+        file = calloc(1, sizeof(ResponseFile));
+
+        if(!file || !(file->path = strdup(path))) {
+            FREE(file);
+            memAllocError("response file");
+        }
+
+        cache->set(cache, file->path, file);
+    }
+
+    // An older buffer is kept since previous results may point into it
+    file->tokens.count = 0;
+    tokenizeResponseFile(data, size, &file->tokens);
+
+    // The status of the file that was read, it may have changed since the stat above
+    file->device = st.st_dev;
+    file->inode = st.st_ino;
+    file->mtime = st.st_mtim;
+    file->size = st.st_size;
+    file->checkedGeneration = eloarg.parseGeneration;
+
+    return file;
+}
+
+static void appendResponseFile(const char *path, ArgVector *arguments, bool *terminated) {
+    ResponseFile *file = loadResponseFile(path);
+
+    if(file->expanding)
+        error("The response file '%s' includes itself.", path);
+
+    file->expanding = true;
+
+    // Start reading the nested files while this one is being expanded
+    for(size_t i = 0; i < file->tokens.count; i++)
+        if(isResponseFileArgument(file->tokens.items[i]))
+            prefetchResponseFile(file->tokens.items[i] + 1);
+
+    for(size_t i = 0; i < file->tokens.count; i++) {
+        char *token = file->tokens.items[i];
+
+        if(!*terminated && isResponseFileArgument(token))
+            appendResponseFile(token + 1, arguments, terminated);
+        else {
+            *terminated |= strcmp(token, "--") == 0; // Arguments after '--' are never expanded
+            argVectorPush(arguments, token);
+        }
+    }
+
+    file->expanding = false;
+}
+
+// Replace every '@file' argument with the arguments listed in the file, recursively
+static void expandResponseFiles(size_t *argc, char ***argv) {
+    ArgVector arguments = { NULL, 0, 0 };
+    bool terminated = false;
+
+    if(!eloarg.responseCache && !(eloarg.responseCache = initHashTable(16)))
+        memAllocError("response file cache");
+
+    eloarg.parseGeneration++;
+
+    for(size_t i = 1; i < *argc; i++)
+        if(isResponseFileArgument((*argv)[i]))
+            prefetchResponseFile((*argv)[i] + 1);
+
+    for(size_t i = 0; i < *argc; i++) {
+        char *argument = (*argv)[i];
+
+        if(i > 0 && !terminated && isResponseFileArgument(argument))
+            appendResponseFile(argument + 1, &arguments, &terminated);
+        else {
+            terminated |= i > 0 && strcmp(argument, "--") == 0;
+            argVectorPush(&arguments, argument);
+        }
+    }
+
+    FREE(eloarg.expandedArgs);
+    eloarg.expandedArgs = arguments.items;
+
+    *argc = arguments.count;
+    *argv = arguments.items;
+}
+
+typedef void (*ConfigHandler)(EloArgOption *option, const char *value, void *userData);
+
+static char *trimBlank(char *start, char **end) {
+    while(start < *end && isBlank(*start))
+        start++;
+
+    while(*end > start && isBlank(*(*end - 1)))
+        (*end)--;
+
+    return start;
+}
+
+// Tokenize 'key = value' lines in place. '[section]' prefixes the following keys ("section.key"),
+// '#' and ';' start comments and a key without a value sets a flag. Values are NUL-terminated
+// where they lie and handed over as views into the data.
+static bool tokenizeConfig(const char *path, char *data, size_t size, ConfigHandler handler, void *userData, char *message, size_t messageSize) {
+    char section[ELOARG_LONG_OPTION_LENGTH + 1] = "";
+    char name[ELOARG_LONG_OPTION_LENGTH + 1];
+    char *cursor = data, *end = data + size;
+    size_t line = 0;
+
+    while(cursor < end) {
+        char *lineEnd = memchr(cursor, '\n', end - cursor);
+        char *next = lineEnd ? lineEnd + 1 : end;
+
+        lineEnd = lineEnd ? lineEnd : end;
+        line++;
+
+        char *key = trimBlank(cursor, &lineEnd);
+        cursor = next;
+
+        if(key == lineEnd || *key == '#' || *key == ';')
+            continue;
+
+        if(*key == '[') {
+            if(*(lineEnd - 1) != ']' || lineEnd - key - 2 > ELOARG_LONG_OPTION_LENGTH) {
+                snprintf(message, messageSize, "%s:%zu: Invalid section.", path, line);
+                return false;
+            }
+
+            memcpy(section, key + 1, lineEnd - key - 2);
+            section[lineEnd - key - 2] = '\0';
+            continue;
+        }
+
+        char *eqPos = memchr(key, '=', lineEnd - key);
+        char *keyEnd = eqPos ? eqPos : lineEnd;
+        char *value = NULL;
+
+        key = trimBlank(key, &keyEnd);
+
+        if(eqPos) {
+            char *valueEnd = lineEnd;
+            value = trimBlank(eqPos + 1, &valueEnd);
+
+            // Strip matching quotes around the value
+            if(valueEnd - value >= 2 && (*value == '"' || *value == '\'') && *(valueEnd - 1) == *value) {
+                value++;
+                valueEnd--;
+            }
+
+            *valueEnd = '\0'; // Overwrites the newline, or the zero byte past the end of the file
+        }
+
+        size_t keyLength = keyEnd - key;
+        EloArgOption *option = NULL;
+
+        if(*section) {
+            size_t sectionLength = strlen(section);
+
+            if(sectionLength + 1 + keyLength <= ELOARG_LONG_OPTION_LENGTH) {
+                memcpy(name, section, sectionLength);
+                name[sectionLength] = '.';
+                memcpy(name + sectionLength + 1, key, keyLength);
+
+                option = (EloArgOption *)eloarg.hashTable->getN(eloarg.hashTable, name, sectionLength + 1 + keyLength);
+            }
+        }
+        else
+            option = (EloArgOption *)eloarg.hashTable->getN(eloarg.hashTable, key, keyLength);
+
+        if(!option || option->valueType == ARG_INFO) {
+            snprintf(message, messageSize, "%s:%zu: Unknown option '%.*s'.", path, line, (int)keyLength, key);
+            return false;
+        }
+
+        if(takesValue(option)) {
+            if(!value || *value == '\0') {
+                snprintf(message, messageSize, "%s:%zu: Missing value for option '%.*s'.", path, line, (int)keyLength, key);
+                return false;
+            }
+
+            handler(option, value, userData);
+        }
+        else {
+            bool enabled = true;
+
+            if(value && !convertBool(value, &enabled)) {
+                snprintf(message, messageSize, "%s:%zu: Invalid value '%s' for option '%.*s'.", path, line, value, (int)keyLength, key);
+                return false;
+            }
+
+            handler(option, enabled ? "" : NULL, userData); // Flags are reported as "" when set, NULL when cleared
+        }
+    }
+
+    return true;
+}
+
+static void collectConfigValue(EloArgOption *option, const char *value, void *userData) {
+    ((const char **)userData)[option->id] = value; // The last occurrence of a key wins
+}
+
+// Read and tokenize a config file into one value per option id, NULL when absent.
+// The values point into the file buffer, handed to the caller through 'buffer' or kept until free.
+static const char **readConfig(const char *path, char **buffer, char *message, size_t messageSize) {
+    size_t size;
+    char *data = readFile(path, &size, NULL);
+    const char **values = calloc(eloarg.count ? eloarg.count : 1, sizeof(char *));
+
+    if(!data || !values || (!buffer && !keepFileBuffer(data))) {
+        snprintf(message, messageSize, data ? "Cannot allocate memory for '%s'." : "Cannot read the config file '%s'.", path);
+        FREE(values);
+        FREE(data);
+
+        return NULL;
+    }
+
+    if(!tokenizeConfig(path, data, size, collectConfigValue, values, message, messageSize)) {
+        FREE(values);
+
+        if(buffer)
+            FREE(data);
+
+        return NULL;
+    }
+
+    if(buffer)
+        *buffer = data;
+
+    return values;
+}
+
+// Option and positional events reported by the scanner
+typedef struct {
+    bool (*option)(EloArgOption *option, const char *value, size_t index, void *userData);
+    bool (*positional)(const char *argument, size_t index, bool rest, void *userData);
+    void *userData;
+} ScanHandlers;
+
+// Incremental scanner fed one argument at a time, shared by every parsing mode
+typedef struct {
+    const ScanHandlers *handlers;
+    size_t index; // Index of the next argument
+    EloArgOption *pending; // Option waiting for its value in the next argument
+    size_t pendingIndex;
+    bool pendingLong;
+    bool terminated; // '--' was met, the remaining arguments are positionals
+    bool stopped; // An ARG_INFO option was met or a handler asked to stop
+    bool failed;
+    char message[ELOARG_LONG_OPTION_LENGTH + 96];
+} Scanner;
+
+static void scannerInit(Scanner *scanner, const ScanHandlers *handlers, size_t firstIndex) {
+    memset(scanner, 0, sizeof(Scanner));
+    scanner->handlers = handlers;
+    scanner->index = firstIndex;
+}
+
+static bool scanFail(Scanner *scanner, const char *formatStr, ...) {
+    va_list args;
+
+    va_start(args, formatStr);
+    vsnprintf(scanner->message, sizeof(scanner->message), formatStr, args);
+    va_end(args);
+
+    scanner->failed = true;
+    scanner->stopped = true;
+
+    return false;
+}
+
+static bool scanMissingValue(Scanner *scanner, EloArgOption *option, bool isLong) {
+    if(isLong)
+        return scanFail(scanner, "Missing value for option: --%s", option->longOption);
+
+    return scanFail(scanner, "Missing value for option: -%c", *option->shortOption);
+}
+
+static bool scanEmit(Scanner *scanner, EloArgOption *option, const char *value, size_t index) {
+    if(option->valueType == ARG_INFO)
+        scanner->stopped = true; // Nothing else matters after --help or --version
+
+    if(scanner->handlers->option && !scanner->handlers->option(option, value, index, scanner->handlers->userData))
+        scanner->stopped = true;
+
+    return !scanner->stopped;
+}
+
+static bool scanPositional(Scanner *scanner, const char *argument, size_t index) {
+    if(scanner->handlers->positional && !scanner->handlers->positional(argument, index, scanner->terminated, scanner->handlers->userData))
+        scanner->stopped = true;
+
+    return !scanner->stopped;
+}
+
+#define TOKEN_BLOCK_SIZE 256 // Arguments classified ahead of the scanner at a time
+
+typedef enum {
+    TOKEN_POSITIONAL, // Also a lone '-' and the values of options
+    TOKEN_LONG, // --name, --name=value
+    TOKEN_SHORT, // -abc, -p443
+    TOKEN_TERMINATOR // --
+} TokenKind;
+
+// Classification of an argument, filled ahead of the scanner. Only long options are walked, the other
+// kinds are told apart by their first bytes, so a positional costs the same whatever its length.
+typedef struct {
+    uint32_t length; // Up to the '=' for a long option with a value
+    uint32_t eqOffset; // Offset of the first '=', 0 if there is none
+    uint32_t hash; // FNV-1a hash of the name of a long option, unused with a resolver
+    uint8_t kind;
+} TokenInfo;
+
+// Hash the name of a long option while looking for the '=' or the end, each byte of the name is read once
+static void hashLongToken(const char *argument, TokenInfo *token) {
+    const char *cursor = argument + 2;
+    uint32_t hash = HASH_FNV_OFFSET_BASIS;
+
+    for(; *cursor != '\0' && *cursor != '='; cursor++) {
+        hash ^= (unsigned char)*cursor;
+        hash *= HASH_FNV_PRIME;
+    }
+
+    token->kind = TOKEN_LONG;
+    token->hash = hash;
+    token->length = cursor - argument;
+    token->eqOffset = *cursor == '=' ? token->length : 0;
+}
+
+// A resolver doesn't need the hash, the long option is only measured
+static void measureLongToken(const char *argument, TokenInfo *token) {
+    const char *cursor = argument + 2;
+
+    while(*cursor != '\0' && *cursor != '=')
+        cursor++;
+
+    token->kind = TOKEN_LONG;
+    token->length = cursor - argument;
+    token->eqOffset = *cursor == '=' ? token->length : 0;
+}
+
+// Options added after the resolver was generated fall back to the hash table
+static EloArgOption *resolveOption(const char *name, size_t length) {
+    EloArgId id = eloarg.resolver(name, length);
+
+    if(id < eloarg.count)
+        return eloarg.options[id];
+
+    return (EloArgOption *)eloarg.hashTable->getN(eloarg.hashTable, name, length);
+}
+
+static void classifyToken(const char *argument, TokenInfo *token) {
+    if(argument[0] != '-' || argument[1] == '\0')
+        token->kind = TOKEN_POSITIONAL;
+    else if(argument[1] != '-')
+        token->kind = TOKEN_SHORT;
+    else if(argument[2] == '\0')
+        token->kind = TOKEN_TERMINATOR;
+    else if(eloarg.resolver)
+        measureLongToken(argument, token);
+    else
+        hashLongToken(argument, token);
+}
+
+// Feed the next argument along with its classification, returns false once scanning must stop
+static bool scanToken(Scanner *scanner, const char *argument, const TokenInfo *token) {
+    size_t index = scanner->index++;
+
+    if(scanner->stopped)
+        return false;
+
+    // Value of the previous option (--port 443, -p 443)
+    if(scanner->pending) {
+        EloArgOption *option = scanner->pending;
+        scanner->pending = NULL;
+
+        if(argument[0] == '-')
+            return scanMissingValue(scanner, option, scanner->pendingLong);
+
+        return scanEmit(scanner, option, argument, scanner->pendingIndex);
+    }
+
+    if(scanner->terminated)
+        return scanPositional(scanner, argument, index);
+
+    // Terminate options parsing, everything after '--' is kept as is
+    if(token->kind == TOKEN_TERMINATOR) {
+        scanner->terminated = true;
+        return true;
+    }
+
+    // Non-option arguments, a lone '-' usually stands for stdin
+    if(token->kind == TOKEN_POSITIONAL)
+        return scanPositional(scanner, argument, index);
+
+    // Check for the long option
+    if(token->kind == TOKEN_LONG) {
+        const char *name = argument + 2; // Skip the '--'
+        const char *eqPos = token->eqOffset ? argument + token->eqOffset : NULL;
+        size_t nameLength = eqPos ? (size_t)(eqPos - name) : token->length - 2;
+
+        // The option part is looked up by length and hash, the argument is never modified (--option=value)
+        EloArgOption *option = eloarg.resolver ? resolveOption(name, nameLength)
+            : (EloArgOption *)eloarg.hashTable->getHashed(eloarg.hashTable, name, nameLength, token->hash);
+
+        if(!option)
+            return scanFail(scanner, "Unknown option: --%.*s.\nUse option '--help' for more information.", (int)nameLength, name);
+
+        if(eqPos) {
+            if(!takesValue(option))
+                return scanFail(scanner, "option '--%s' doesn't allow an argument.", option->longOption);
+            else if(*(eqPos + 1) == '\0')
+                return scanFail(scanner, "Missing value for option: --%s=", option->longOption);
+
+            return scanEmit(scanner, option, eqPos + 1, index); // Value after '='
+        }
+
+        if(takesValue(option)) {
+            scanner->pending = option;
+            scanner->pendingIndex = index;
+            scanner->pendingLong = true;
+
+            return true;
+        }
+
+        return scanEmit(scanner, option, NULL, index);
+    }
+
+    // Combined short options
+    for(const char *opt = argument + 1; *opt; opt++) {
+        EloArgOption *option = eloarg.shortOptions[(unsigned char)*opt];
+
+        if(!option)
+            return scanFail(scanner, "Unknown option '%c'.\nUse option '--help' for more information.", *opt);
+
+        if(!takesValue(option)) {
+            if(!scanEmit(scanner, option, NULL, index))
+                return false;
+
+            continue;
+        }
+
+        if(*(opt + 1) != '\0') // -p443
+            return scanEmit(scanner, option, opt + 1, index);
+
+        scanner->pending = option; // -p 443
+        scanner->pendingIndex = index;
+        scanner->pendingLong = false;
+    }
+
+    return true;
+}
+
+
+// Feed the next argument, returns false once scanning must stop
+static bool scanArgument(Scanner *scanner, const char *argument) {
+    TokenInfo token;
+
+    classifyToken(argument, &token);
+
+    return scanToken(scanner, argument, &token);
+}
+
+// Scan the arguments [begin, end), classifying them a block at a time. Stops after '--' if untilTerminator is set.
+static bool scanRange(Scanner *scanner, char **argv, size_t begin, size_t end, bool untilTerminator) {
+    TokenInfo tokens[TOKEN_BLOCK_SIZE];
+
+    for(size_t blockStart = begin; blockStart < end; blockStart += TOKEN_BLOCK_SIZE) {
+        size_t blockLength = end - blockStart < TOKEN_BLOCK_SIZE ? end - blockStart : TOKEN_BLOCK_SIZE;
+
+        for(size_t i = 0; i < blockLength; i++)
+            classifyToken(argv[blockStart + i], &tokens[i]);
+
+        for(size_t i = 0; i < blockLength; i++) {
+            if(!scanToken(scanner, argv[blockStart + i], &tokens[i]))
+                return false;
+
+            if(untilTerminator && scanner->terminated)
+                return true;
+        }
+    }
+
+    return true;
+}
+
+// Call once the arguments are exhausted
+static bool scanFinish(Scanner *scanner) {
+    if(scanner->pending && !scanner->stopped) {
+        EloArgOption *option = scanner->pending;
+        scanner->pending = NULL;
+
+        return scanMissingValue(scanner, option, scanner->pendingLong);
+    }
+
+    return !scanner->failed;
+}
+
+static void scanArgv(Scanner *scanner, size_t argc, char **argv) {
+    scanRange(scanner, argv, 1, argc, false);
+
+    if(!scanFinish(scanner))
+        error("%s", scanner->message);
+}
+
+static void recordEvent(EloArgId id, const char *value, size_t index) {
+    if(eloarg.eventCount == eloarg.eventCapacity) {
+        size_t capacity = eloarg.eventCapacity ? eloarg.eventCapacity * 2 : 16;
+        EloArgEvent *events = realloc(eloarg.eventLog, capacity * sizeof(EloArgEvent));
+
+        if(!events)
+            memAllocError("EloArgEvent log");
+
+        eloarg.eventLog = events;
+        eloarg.eventCapacity = capacity;
+    }
+
+    EloArgEvent *event = &eloarg.eventLog[eloarg.eventCount++];
+
+    event->id = id;
+    event->value = value;
+    event->index = index;
+}
+
+static bool storeParsedOption(EloArgOption *option, const char *value, size_t index, void *userData) {
+    storeOption(option, value, ARG_SOURCE_ARGV);
+    recordEvent(option->id, value, index);
+
+    return true;
+}
+
+// Values read from a file descriptor live in a reused buffer, the option keeps a copy of its last one
+static bool storeCopiedOption(EloArgOption *option, const char *value, size_t index, void *userData) {
+    char *copy = NULL;
+
+    if(value && !(copy = strdup(value)))
+        memAllocError("option value");
+
+    storeOption(option, copy, ARG_SOURCE_ARGV);
+
+    // A repeated option replaces its copy, so memory doesn't grow with the stream
+    if(copy && option->value == copy) {
+        FREE(option->ownedValue);
+        option->ownedValue = copy;
+    }
+    else
+        FREE(copy);
+
+    return true;
+}
+
+static bool storeParsedPositional(const char *argument, size_t index, bool rest, void *userData) {
+    if(rest) {
+        char **argv = userData;
+
+        // Arguments after '--' are contiguous, keep them as a slice of argv
+        if(eloarg.restCount++ == 0)
+            eloarg.restArgs = argv + index;
+    }
+    else {
+        eloarg.positionalArgs[eloarg.positionalCount++] = (char *)argument; // Points into argv
+        recordEvent(ELOARG_POSITIONAL_ID, argument, index);
+    }
+
+    return true;
+}
+
+// Index the environment variable name of every option with a long name (port -> APP_PORT)
+static void buildEnvironmentIndex() {
+    size_t prefixLength = strlen(eloarg.environmentPrefix), namesSize = 0;
+
+    if(eloarg.environmentIndex)
+        eloarg.environmentIndex->free(&eloarg.environmentIndex);
+
+    FREE(eloarg.environmentNames);
+
+    for(EloArgId id = 0; id < eloarg.count; id++)
+        namesSize += prefixLength + strlen(eloarg.options[id]->longOption) + 1;
+
+    eloarg.environmentIndex = initHashTable(eloarg.count * 2);
+    eloarg.environmentNames = malloc(namesSize);
+
+    if(!eloarg.environmentIndex || !eloarg.environmentNames)
+        memAllocError("environment index");
+
+    char *name = eloarg.environmentNames;
+
+    for(EloArgId id = 0; id < eloarg.count; id++) {
+        EloArgOption *option = eloarg.options[id];
+
+        if(!*option->longOption || option->valueType == ARG_INFO)
+            continue;
+
+        char *cursor = stpcpy(name, eloarg.environmentPrefix);
+
+        for(const char *c = option->longOption; *c; c++)
+            *cursor++ = *c == '-' ? '_' : toupper((unsigned char)*c);
+
+        *cursor = '\0';
+
+        eloarg.environmentIndex->set(eloarg.environmentIndex, name, option);
+        name = cursor + 1;
+    }
+
+    eloarg.environmentIndexedCount = eloarg.count;
+}
+
+// Single pass over environ, options provided on the command line take precedence
+static void mergeEnvironment() {
+    size_t prefixLength = strlen(eloarg.environmentPrefix);
+
+    if(!eloarg.environmentIndex || eloarg.environmentIndexedCount != eloarg.count)
+        buildEnvironmentIndex();
+
+    for(char **entry = environ; *entry; entry++) {
+        const char *variable = *entry;
+
+        if(strncmp(variable, eloarg.environmentPrefix, prefixLength) != 0)
+            continue;
+
+        const char *eqPos = strchr(variable + prefixLength, '=');
+
+        if(!eqPos)
+            continue;
+
+        EloArgOption *option = (EloArgOption *)eloarg.environmentIndex->getN(eloarg.environmentIndex, variable, eqPos - variable);
+
+        if(!option || option->source > ARG_SOURCE_ENV)
+            continue;
+
+        const char *value = eqPos + 1;
+
+        if(takesValue(option)) {
+            if(*value == '\0')
+                continue; // Set but empty, same as unset
+
+            storeOption(option, value, ARG_SOURCE_ENV);
+        }
+        else {
+            bool enabled;
+
+            if(!convertBool(value, &enabled))
+                error("Invalid value '%s' for environment variable: %.*s", value, (int)(eqPos - variable), variable);
+
+            if(enabled)
+                storeOption(option, NULL, ARG_SOURCE_ENV);
+        }
+    }
+}
+
+// A required option is satisfied once provided by any source or given a default, checked a word at a time
+static void checkRequiredOptions() {
+    for(size_t word = 0; word < ELOARG_MASK_WORDS(eloarg.count); word++) {
+        uint64_t missing = eloarg.requiredMask[word] & ~(eloarg.providedMask[word] | eloarg.defaultMask[word]);
+
+        if(missing) {
+            EloArgOption *option = eloarg.options[word * 64 + __builtin_ctzll(missing)];
+
+            if(*option->longOption)
+                error("Missing required option: '--%s'\nUse option '--help' for more information.", option->longOption);
+            else
+                error("Missing required option: '-%s'\nUse option '--help' for more information.", option->shortOption);
+        }
+    }
+}
+
+// Reset the parse results, returns false if there is nothing to parse
+static bool beginParse(size_t *argc, char ***argv) {
+    if(*argc == 0)
+        return false;
+
+    if(eloarg.responseFilesEnabled)
+        expandResponseFiles(argc, argv);
+
+    // Positionals can't outnumber the arguments, one allocation holds them all
+    FREE(eloarg.positionalArgs);
+    eloarg.positionalArgs = malloc(*argc * sizeof(char *));
+    eloarg.positionalCount = 0;
+    eloarg.restArgs = *argv + *argc;
+    eloarg.restCount = 0;
+    eloarg.eventCount = 0;
+
+    if(!eloarg.positionalArgs)
+        memAllocError("positional arguments");
+
+    return true;
+}
+
+static void finishParse() {
+    if(eloarg.environmentPrefix)
+        mergeEnvironment();
+
+    checkRequiredOptions();
+}
+
+static void parseSerial(size_t argc, char **argv) {
+    ScanHandlers handlers = { storeParsedOption, storeParsedPositional, argv };
+    Scanner scanner;
+
+    scannerInit(&scanner, &handlers, 1);
+    scanArgv(&scanner, argc, argv);
+
+    // Return if an ARG_INFO option was met (for --help and --version etc.)
+    if(scanner.stopped)
+        return;
+
+    finishParse();
+}
+
+static void eloArgParse(int argCount, char **argValues) {
+    size_t argc = argCount;
+    char **argv = argValues;
+
+    if(beginParse(&argc, &argv))
+        parseSerial(argc, argv);
+}
+
+// An option or a positional argument (option NULL) met by a chunk, in argv order
+typedef struct {
+    EloArgOption *option;
+    const char *value;
+    size_t index;
+} ChunkItem;
+
+typedef struct {
+    size_t begin; // Arguments [begin, end) of argv
+    size_t end;
+    ChunkItem *items;
+    size_t itemCount;
+    size_t itemCapacity;
+    bool outOfMemory;
+    size_t terminatorIndex; // Index of '--' if the scanner met it
+    ScanHandlers handlers;
+    Scanner scanner; // Left as the chunk ended: failed, stopped or terminated
+} ParseChunk;
+
+typedef struct {
+    ParseChunk *chunks;
+    size_t chunkCount;
+    size_t argc;
+    char **argv;
+} ParallelParse;
+
+static bool pushChunkItem(ParseChunk *chunk, EloArgOption *option, const char *value, size_t index) {
+    if(chunk->itemCount == chunk->itemCapacity) {
+        size_t capacity = chunk->itemCapacity ? chunk->itemCapacity * 2 : 256;
+        ChunkItem *items = realloc(chunk->items, capacity * sizeof(ChunkItem));
+
+        if(!items) {
+            chunk->outOfMemory = true;
+            return false;
+        }
+
+        chunk->items = items;
+        chunk->itemCapacity = capacity;
+    }
+
+    chunk->items[chunk->itemCount++] = (ChunkItem){ option, value, index };
+
+    return true;
+}
+
+static bool collectChunkOption(EloArgOption *option, const char *value, size_t index, void *userData) {
+    return pushChunkItem(userData, option, value, index);
+}
+
+static bool collectChunkPositional(const char *argument, size_t index, bool rest, void *userData) {
+    return pushChunkItem(userData, NULL, argument, index);
+}
+
+/*
+    Scan one chunk on a pool thread. Looking back one argument is enough to stitch the chunks:
+    a value never starts with '-', so the argument before the chunk is either a value or positional
+    (nothing pending) or an option scanned on its own, which tells whether it waits for a value.
+    A '--' or an ARG_INFO option met earlier is handled by the merge, which ignores later chunks.
+*/
+static void parseChunk(size_t index, void *userData) {
+    ParallelParse *parse = userData;
+    ParseChunk *chunk = &parse->chunks[index];
+
+    chunk->handlers = (ScanHandlers){ collectChunkOption, collectChunkPositional, chunk };
+    scannerInit(&chunk->scanner, &chunk->handlers, chunk->begin);
+
+    if(chunk->begin > 1) {
+        ScanHandlers none = { NULL, NULL, NULL };
+        Scanner probe;
+
+        scannerInit(&probe, &none, chunk->begin - 1);
+        scanArgument(&probe, parse->argv[chunk->begin - 1]);
+
+        if(probe.pending && !probe.stopped) {
+            chunk->scanner.pending = probe.pending;
+            chunk->scanner.pendingIndex = probe.pendingIndex;
+            chunk->scanner.pendingLong = probe.pendingLong;
+        }
+    }
+
+    scanRange(&chunk->scanner, parse->argv, chunk->begin, chunk->end, true);
+
+    if(chunk->scanner.terminated)
+        chunk->terminatorIndex = chunk->scanner.index - 1;
+
+    // The option ending the last chunk has no value to wait for
+    if(chunk->end == parse->argc)
+        scanFinish(&chunk->scanner);
+}
+
+static ThreadPool *parseThreadPool(size_t threads) {
+    if(eloarg.threadPool && threads != 0 && eloarg.threadPool->getThreadCount(eloarg.threadPool) != threads)
+        eloarg.threadPool->free(&eloarg.threadPool);
+
+    if(!eloarg.threadPool)
+        eloarg.threadPool = initThreadPool(threads);
+
+    return eloarg.threadPool;
+}
+
+static void eloArgParseParallel(int argCount, char **argValues, size_t threads) {
+    size_t argc = argCount;
+    char **argv = argValues;
+
+    if(!beginParse(&argc, &argv))
+        return;
+
+    ThreadPool *threadPool = argc >= 2 * ELOARG_PARALLEL_CHUNK_SIZE ? parseThreadPool(threads) : NULL;
+
+    // Not worth the threads
+    if(!threadPool || threadPool->getThreadCount(threadPool) < 2)
+        return parseSerial(argc, argv);
+
+    // A few chunks per thread so the threads done early can take more
+    size_t chunkSize = (argc - 1) / (threadPool->getThreadCount(threadPool) * 4);
+    chunkSize = chunkSize < ELOARG_PARALLEL_CHUNK_SIZE ? ELOARG_PARALLEL_CHUNK_SIZE : chunkSize;
+
+    ParallelParse parse = { NULL, (argc - 1 + chunkSize - 1) / chunkSize, argc, argv };
+
+    if(!(parse.chunks = calloc(parse.chunkCount, sizeof(ParseChunk))))
+        memAllocError("argument chunks");
+
+    for(size_t i = 0; i < parse.chunkCount; i++) {
+        parse.chunks[i].begin = 1 + i * chunkSize;
+        parse.chunks[i].end = i + 1 == parse.chunkCount ? argc : 1 + (i + 1) * chunkSize;
+    }
+
+    threadPool->run(threadPool, parse.chunkCount, parseChunk, &parse);
+
+    // Store the results in argv order, as the serial parse does, up to the first error, '--' or ARG_INFO option
+    bool stopped = false;
+
+    for(size_t i = 0; i < parse.chunkCount && !stopped; i++) {
+        ParseChunk *chunk = &parse.chunks[i];
+
+        for(size_t j = 0; j < chunk->itemCount; j++) {
+            ChunkItem *item = &chunk->items[j];
+
+            if(item->option)
+                storeParsedOption(item->option, item->value, item->index, NULL);
+            else
+                storeParsedPositional(item->value, item->index, false, argv);
+        }
+
+        if(chunk->outOfMemory || chunk->scanner.failed) {
+            char message[sizeof(chunk->scanner.message)];
+            bool outOfMemory = chunk->outOfMemory;
+
+            memcpy(message, chunk->scanner.message, sizeof(message));
+
+            for(size_t k = 0; k < parse.chunkCount; k++)
+                FREE(parse.chunks[k].items);
+
+            FREE(parse.chunks);
+
+            if(outOfMemory)
+                memAllocError("parsed arguments");
+
+            error("%s", message);
+        }
+
+        if(chunk->scanner.terminated) {
+            eloarg.restArgs = argv + chunk->terminatorIndex + 1;
+            eloarg.restCount = argc - chunk->terminatorIndex - 1;
+            break;
+        }
+
+        stopped = chunk->scanner.stopped; // ARG_INFO option
+    }
+
+    for(size_t i = 0; i < parse.chunkCount; i++)
+        FREE(parse.chunks[i].items);
+
+    FREE(parse.chunks);
+
+    if(!stopped)
+        finishParse();
+}
+
+typedef struct {
+    EloArgOptionHandler onOption;
+    EloArgPositionalHandler onPositional;
+    void *userData;
+} StreamHandlers;
+
+static bool streamOption(EloArgOption *option, const char *value, size_t index, void *userData) {
+    StreamHandlers *stream = userData;
+
+    return !stream->onOption || stream->onOption(option->id, value, index, stream->userData);
+}
+
+static bool streamPositional(const char *argument, size_t index, bool rest, void *userData) {
+    StreamHandlers *stream = userData;
+
+    return !stream->onPositional || stream->onPositional(argument, index, stream->userData);
+}
+
+static void eloArgStream(int argc, char **argv, EloArgOptionHandler onOption, EloArgPositionalHandler onPositional, void *userData) {
+    StreamHandlers stream = { onOption, onPositional, userData };
+    ScanHandlers handlers = { streamOption, streamPositional, &stream };
+    Scanner scanner;
+
+    scannerInit(&scanner, &handlers, 1);
+    scanArgv(&scanner, argc, argv);
+}
+
+static bool matchBufferOption(EloArgOption *option, const char *value, size_t index, void *userData) {
+    EloArgMatch *match = (EloArgMatch *)userData + option->id;
+
+    match->count++;
+
+    if(value) {
+        match->value = value;
+        match->length = strlen(value);
+    }
+
+    return true;
+}
+
+static bool eloArgParseBuffer(const char *buffer, size_t length, EloArgMatch *matches) {
+    ScanHandlers handlers = { matchBufferOption, NULL, matches };
+    Scanner scanner;
+    const char *end = buffer + length, *terminator;
+
+    memset(matches, 0, eloarg.count * sizeof(EloArgMatch));
+    scannerInit(&scanner, &handlers, 0);
+
+    // Arguments are NUL-terminated in the buffer, a truncated last argument is ignored
+    for(const char *argument = buffer; argument < end; argument = terminator + 1) {
+        if(!(terminator = memchr(argument, '\0', end - argument)))
+            break;
+
+        if(argument == buffer)
+            continue; // Program name
+
+        if(!scanArgument(&scanner, argument))
+            break;
+    }
+
+    return scanFinish(&scanner);
+}
+
+static void eloArgParseFd(int fd, char delimiter, EloArgPositionalHandler onPositional, void *userData) {
+    char *buffer = malloc(ELOARG_FD_BUFFER_SIZE + 1); // Room to terminate the last argument
+    size_t length = 0; // Bytes of an argument carried over to the next read
+    bool reading = true;
+
+    if(!buffer)
+        memAllocError("argument buffer");
+
+    StreamHandlers stream = { NULL, onPositional, userData };
+    ScanHandlers handlers = { storeCopiedOption, streamPositional, &stream };
+    Scanner scanner;
+
+    scannerInit(&scanner, &handlers, 0);
+
+    while(reading && !scanner.stopped) {
+        ssize_t bytesRead = read(fd, buffer + length, ELOARG_FD_BUFFER_SIZE - length);
+
+        if(bytesRead < 0) {
+            if(errno == EINTR)
+                continue;
+
+            FREE(buffer);
+            error("Cannot read the arguments from file descriptor %d.", fd);
+        }
+
+        char *start = buffer, *end = buffer + length + bytesRead, *delimiterPos;
+
+        reading = bytesRead > 0;
+
+        if(!reading && length > 0)
+            *end++ = delimiter; // Terminate the last argument at the end of the input
+
+        // Empty arguments are kept, like in argv
+        while((delimiterPos = memchr(start, delimiter, end - start))) {
+            *delimiterPos = '\0';
+
+            if(!scanArgument(&scanner, start))
+                break;
+
+            start = delimiterPos + 1;
+        }
+
+        length = end - start;
+
+        if(length == ELOARG_FD_BUFFER_SIZE) {
+            FREE(buffer);
+            error("Argument longer than %u bytes read from file descriptor %d.", ELOARG_FD_BUFFER_SIZE, fd);
+        }
+
+        memmove(buffer, start, length);
+    }
+
+    FREE(buffer);
+
+    if(!scanFinish(&scanner))
+        error("%s", scanner.message);
+
+    if(scanner.stopped)
+        return;
+
+    finishParse();
+}
+
+typedef struct {
+    EloArgMatch *matches;
+    const char **arguments; // Positionals, then the arguments after '--'
+    size_t positionalCount;
+    size_t restCount;
+} SnapshotBuilder;
+
+static bool snapshotOption(EloArgOption *option, const char *value, size_t index, void *userData) {
+    return matchBufferOption(option, value, index, ((SnapshotBuilder *)userData)->matches);
+}
+
+static bool snapshotPositional(const char *argument, size_t index, bool rest, void *userData) {
+    SnapshotBuilder *builder = userData;
+
+    builder->arguments[builder->positionalCount + builder->restCount] = argument;
+    *(rest ? &builder->restCount : &builder->positionalCount) += 1;
+
+    return true;
+}
+
+// Wait until the readers registered in a phase are gone
+static void drainSnapshotReaders(uint32_t phase) {
+    while(__atomic_load_n(&eloarg.snapshotReaders[phase].count, __ATOMIC_ACQUIRE) != 0)
+        sched_yield();
+}
+
+static bool eloArgPublish(int argc, char **argv) {
+    size_t bytes = 0;
+
+    for(int i = 1; i < argc; i++)
+        bytes += strlen(argv[i]) + 1;
+
+    // The snapshot, its matches, its argument pointers and the strings share one block
+    size_t argumentCount = argc > 1 ? argc - 1 : 0;
+    size_t matchesOffset = sizeof(EloArgSnapshot);
+    size_t argumentsOffset = matchesOffset + eloarg.count * sizeof(EloArgMatch);
+    size_t stringsOffset = argumentsOffset + argumentCount * sizeof(char *);
+    char *block = calloc(1, stringsOffset + bytes);
+
+    if(!block)
+        return false;
+
+    EloArgSnapshot *snapshot = (EloArgSnapshot *)block;
+    SnapshotBuilder builder = { (EloArgMatch *)(block + matchesOffset), (const char **)(block + argumentsOffset), 0, 0 };
+    ScanHandlers handlers = { snapshotOption, snapshotPositional, &builder };
+    Scanner scanner;
+    char *strings = block + stringsOffset;
+
+    scannerInit(&scanner, &handlers, 1);
+
+    // Values point into the copies, the snapshot doesn't depend on argv
+    for(int i = 1; i < argc; i++) {
+        size_t length = strlen(argv[i]) + 1;
+
+        memcpy(strings, argv[i], length);
+
+        if(!scanArgument(&scanner, strings))
+            break;
+
+        strings += length;
+    }
+
+    bool valid = scanFinish(&scanner);
+
+    // A required option may also come from the sources merged by parse
+    for(EloArgId id = 0; valid && !scanner.stopped && id < eloarg.count; id++)
+        valid = eloarg.options[id]->valueType != ARG_REQUIRED || builder.matches[id].count || eloarg.options[id]->value;
+
+    if(!valid) {
+        free(block);
+        return false;
+    }
+
+    snapshot->matches = builder.matches;
+    snapshot->positionals = builder.arguments;
+    snapshot->positionalCount = builder.positionalCount;
+    snapshot->rest = builder.arguments + builder.positionalCount;
+    snapshot->restCount = builder.restCount;
+    snapshot->count = eloarg.count;
+
+    pthread_mutex_lock(&eloarg.publishMutex);
+
+    snapshot->generation = ++eloarg.snapshotGeneration;
+
+    EloArgSnapshot *previous = __atomic_exchange_n(&eloarg.snapshot, snapshot, __ATOMIC_SEQ_CST);
+
+    /*
+        A reader may have loaded the previous snapshot after registering in either phase.
+        Flipping the phase twice and draining the counter left behind each time waits them all out,
+        readers registering afterwards can only load the new snapshot.
+    */
+    for(int flip = 0; flip < 2; flip++) {
+        uint32_t phase = __atomic_load_n(&eloarg.snapshotPhase, __ATOMIC_RELAXED);
+
+        __atomic_store_n(&eloarg.snapshotPhase, phase ^ 1, __ATOMIC_SEQ_CST);
+        drainSnapshotReaders(phase);
+    }
+
+    pthread_mutex_unlock(&eloarg.publishMutex);
+
+    free(previous);
+
+    return true;
+}
+
+static EloArgSnapshotRef eloArgAcquire() {
+    EloArgSnapshotRef ref;
+
+    ref.phase = __atomic_load_n(&eloarg.snapshotPhase, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&eloarg.snapshotReaders[ref.phase].count, 1, __ATOMIC_SEQ_CST);
+    ref.snapshot = __atomic_load_n(&eloarg.snapshot, __ATOMIC_SEQ_CST);
+
+    return ref;
+}
+
+static void eloArgRelease(EloArgSnapshotRef ref) {
+    __atomic_fetch_sub(&eloarg.snapshotReaders[ref.phase].count, 1, __ATOMIC_RELEASE);
+}
+
+static bool eloArgHas(const char *key) {
+    EloArgOption *option = (EloArgOption *)eloarg.hashTable->get(eloarg.hashTable, key);
+    
+    return option && option->provided;
+}
+
+static const char *eloArgGet(const char *key) {
+    EloArgOption *option = (EloArgOption *)eloarg.hashTable->get(eloarg.hashTable, key);
+
+    return option ? option->value : NULL;
+}
+
+static size_t eloArgCount(const char *key) {
+    EloArgOption *option = (EloArgOption *)eloarg.hashTable->get(eloarg.hashTable, key);
+
+    return option && option->provided ? option->count : 0;
+}
+
+static char **eloArgPositionals(size_t *count) {
+    if(count)
+        *count = eloarg.positionalCount;
+
+    return eloarg.positionalArgs;
+}
+
+static char **eloArgRest(size_t *count) {
+    if(count)
+        *count = eloarg.restCount;
+
+    return eloarg.restArgs;
+}
+
+// Store the values of a config file, returns one value per option id, NULL when absent
+static const char **storeConfig(const char *path) {
+    char message[PATH_MAX + ELOARG_LONG_OPTION_LENGTH + 64];
+    const char **values = readConfig(path, NULL, message, sizeof(message));
+
+    if(!values)
+        error("%s", message);
+
+    for(EloArgId id = 0; id < eloarg.count; id++)
+        if(values[id]) // Flags are "" when set
+            storeOption(eloarg.options[id], takesValue(eloarg.options[id]) ? values[id] : NULL, ARG_SOURCE_FILE);
+
+    return values;
+}
+
+static void eloArgLoadConfig(const char *path) {
+    const char **values = storeConfig(path);
+
+    FREE(values);
+}
+
+static bool sameValue(const char *a, const char *b) {
+    return a == b || (a && b && strcmp(a, b) == 0);
+}
+
+// The type a new value will be converted to once applied: the binding's when the option is bound
+static bool validConfigValue(const EloArgOption *option, const char *value) {
+    ArgDataType types[] = { option->dataType, option->binding ? option->bindType : ARG_TYPE_STRING };
+    EloArgValue converted;
+
+    if(!value || !takesValue(option))
+        return true; // Flags were checked by the tokenizer
+
+    for(size_t i = 0; i < sizeof(types) / sizeof(*types); i++)
+        if(types[i] != ARG_TYPE_STRING && types[i] != ARG_TYPE_PATH && types[i] != ARG_TYPE_COUNT && !convertValue(value, types[i], &converted))
+            return false;
+
+    return true;
+}
+
+// Runs on the watcher thread: it reads nothing the parse writes and never exits, the options are left
+// to the change handler, which applies the new values on the application's side (setRuntime, its own thread)
+static void reloadConfig() {
+    char message[PATH_MAX + ELOARG_LONG_OPTION_LENGTH + 64];
+    char *buffer;
+    const char **values = readConfig(eloarg.watchPath, &buffer, message, sizeof(message));
+
+    if(!values) {
+        fprintf(stderr, "%s: %s Keeping the previous configuration.\n", LIBRARY_NAME, message);
+        return;
+    }
+
+    // Reject the whole reload rather than hand over a value that can't be converted
+    for(EloArgId id = 0; id < eloarg.configValueCount; id++) {
+        const EloArgOption *option = eloarg.options[id];
+
+        if(!sameValue(eloarg.configValues[id], values[id]) && !validConfigValue(option, values[id])) {
+            fprintf(stderr, "%s: %s: Invalid value '%s' for option '%s'. Keeping the previous configuration.\n",
+                    LIBRARY_NAME, eloarg.watchPath, values[id], *option->longOption ? option->longOption : option->shortOption);
+            FREE(values);
+            FREE(buffer);
+
+            return;
+        }
+    }
+
+    if(eloarg.onConfigChange)
+        for(EloArgId id = 0; id < eloarg.configValueCount; id++)
+            if(!sameValue(eloarg.configValues[id], values[id]))
+                eloarg.onConfigChange(id, eloarg.configValues[id], values[id], eloarg.configChangeUserData);
+
+    // The previous values stay valid until every handler returned
+    FREE(eloarg.configValues);
+    FREE(eloarg.configBuffer);
+    eloarg.configValues = values;
+    eloarg.configBuffer = buffer;
+}
+
+static void *watchConfigFile(void *arg) {
+    const char *slash = strrchr(eloarg.watchPath, '/');
+    const char *fileName = slash ? slash + 1 : eloarg.watchPath;
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct pollfd fds[2] = {
+        { .fd = eloarg.watchFd, .events = POLLIN },
+        { .fd = eloarg.watchStopFds[0], .events = POLLIN }
+    };
+
+    for(;;) {
+        if(poll(fds, 2, -1) < 0) {
+            if(errno == EINTR)
+                continue; // The revents are stale
+
+            break;
+        }
+
+        if(fds[1].revents)
+            break; // eloArgFree() asked us to stop
+
+        if(!(fds[0].revents & POLLIN))
+            continue;
+
+        // Non-blocking, a spurious wakeup must not keep eloArgFree() from joining
+        ssize_t length = read(eloarg.watchFd, buffer, sizeof(buffer));
+        bool changed = false;
+
+        for(char *cursor = buffer; length > 0 && cursor < buffer + length;) {
+            struct inotify_event *event = (struct inotify_event *)cursor;
+
+            changed |= event->len > 0 && strcmp(event->name, fileName) == 0;
+            cursor += sizeof(struct inotify_event) + event->len;
+        }
+
+        if(changed)
+            reloadConfig();
+    }
+
+    return NULL;
+}
+
+static void eloArgWatchConfig(const char *path, EloArgChangeHandler onChange, void *userData) {
+    if(eloarg.watching)
+        error("The config file '%s' is already watched.", eloarg.watchPath);
+
+    const char *slash = strrchr(path, '/');
+    char directory[PATH_MAX];
+
+    // Watch the directory, editors often replace the file by renaming a new one over it.
+    // Creation isn't watched: a new file is still empty, it is read once closed after writing.
+    if(slash)
+        snprintf(directory, sizeof(directory), "%.*s", (int)(slash == path ? 1 : slash - path), path);
+    else
+        strcpy(directory, ".");
+
+    if(!(eloarg.watchPath = strdup(path)))
+        memAllocError("config file path");
+
+    // Watching before the first load so no change is missed in between
+    eloarg.watchFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+
+    if(eloarg.watchFd < 0 || inotify_add_watch(eloarg.watchFd, directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+        error("Cannot watch the config file '%s'.", path);
+
+    // The values of the watched file alone are the reference the reloads are compared to,
+    // whatever other config files were loaded
+    eloarg.configValues = storeConfig(path);
+    eloarg.configValueCount = eloarg.count;
+
+    eloarg.onConfigChange = onChange;
+    eloarg.configChangeUserData = userData;
+
+    if(pipe(eloarg.watchStopFds) < 0)
+        error("Cannot watch the config file '%s'.", path);
+
+    if(pthread_create(&eloarg.watcher, NULL, watchConfigFile, NULL) != 0) {
+        close(eloarg.watchStopFds[0]);
+        close(eloarg.watchStopFds[1]);
+        error("Cannot start the watcher thread for the config file '%s'.", path);
+    }
+
+    eloarg.watching = true;
+}
+
+static void eloArgSetDefault(EloArgId id, const char *value) {
+    if(id >= eloarg.count)
+        error("Cannot set the default of the unknown option id %u.", id);
+    else if(!value || !takesValue(eloarg.options[id]))
+        error("Only options taking a value can have a default value.");
+
+    eloarg.options[id]->defaultValue = value;
+    ELOARG_MASK_SET(eloarg.defaultMask, id);
+    storeOption(eloarg.options[id], value, ARG_SOURCE_DEFAULT);
+}
+
+static void eloArgEnvPrefix(const char *prefix) {
+    FREE(eloarg.environmentPrefix);
+
+    if(prefix && !(eloarg.environmentPrefix = strdup(prefix)))
+        memAllocError("environment prefix");
+
+    eloarg.environmentIndexedCount = 0; // Names change with the prefix
+}
+
+static void eloArgResponseFiles(bool enabled) {
+    eloarg.responseFilesEnabled = enabled;
+}
+
+static const EloArgEvent *eloArgEvents(size_t *count) {
+    if(count)
+        *count = eloarg.eventCount;
+
+    return eloarg.eventLog;
+}
+
+static bool eloArgHasId(EloArgId id) {
+    return id < eloarg.count && eloarg.options[id]->provided;
+}
+
+static const char *eloArgGetId(EloArgId id) {
+    if(id >= eloarg.count)
+        return NULL;
+
+    return eloarg.options[id]->value;
+}
+
+static size_t eloArgCountId(EloArgId id) {
+    if(id >= eloarg.count)
+        return 0;
+
+    EloArgOption *option = eloarg.options[id];
+
+    return option->provided ? option->count : 0;
+}
+
+static int64_t eloArgGetInt64(EloArgId id) {
+    return id < eloarg.count ? typedValue(eloarg.options[id], ARG_TYPE_INT64).i64 : 0;
+}
+
+static uint64_t eloArgGetUint64(EloArgId id) {
+    return id < eloarg.count ? typedValue(eloarg.options[id], ARG_TYPE_UINT64).u64 : 0;
+}
+
+static double eloArgGetDouble(EloArgId id) {
+    return id < eloarg.count ? typedValue(eloarg.options[id], ARG_TYPE_DOUBLE).f64 : 0;
+}
+
+static bool eloArgGetBool(EloArgId id) {
+    return id < eloarg.count && typedValue(eloarg.options[id], ARG_TYPE_BOOL).boolean;
+}
+
+static uint64_t eloArgGetSize(EloArgId id) {
+    return id < eloarg.count ? typedValue(eloarg.options[id], ARG_TYPE_SIZE).u64 : 0;
+}
+
+static uint64_t eloArgGetDuration(EloArgId id) {
+    return id < eloarg.count ? typedValue(eloarg.options[id], ARG_TYPE_DURATION).u64 : 0;
+}
+
+// Convert the value once and publish it to the readers of the option, without touching the parsed value
+static bool eloArgSetRuntime(const char *key, const char *value) {
+    EloArgOption *option = (EloArgOption *)eloarg.hashTable->get(eloarg.hashTable, key);
+    EloArgValue converted = { 0 };
+
+    if(!option || !value || option->dataType == ARG_TYPE_STRING || !convertValue(value, option->dataType, &converted))
+        return false;
+
+    publishRuntime(option, converted);
+
+    return true;
+}
+
+static EloArgValue eloArgGetRuntime(EloArgId id) {
+    EloArgValue value = { 0 };
+
+    return id < eloarg.count ? eloArgLoadCell(&eloarg.options[id]->runtime) : value;
+}
+
+static const EloArgCell *eloArgRuntimeCell(EloArgId id) {
+    return id < eloarg.count ? &eloarg.options[id]->runtime : NULL;
+}
+
+typedef struct {
+    size_t *invalid;
+    size_t invalidCount;
+    size_t invalidCapacity;
+    size_t bytes; // Path storage needed by the chunk
+    size_t offset; // Start of the chunk in the path storage
+    bool outOfMemory;
+} BulkChunk;
+
+typedef struct {
+    const char **inputs;
+    size_t count;
+    ArgDataType type;
+    EloArgArray *array;
+    BulkChunk *chunks;
+} BulkConversion;
+
+static bool convertInt64Fast(const char *str, int64_t *out) {
+    size_t length = strlen(str);
+    size_t sign = *str == '-' || *str == '+';
+    uint64_t magnitude;
+
+    // At most 19 digits, always in range apart from the few above INT64_MAX
+    if(!parseDigitsSwar(str + sign, length - sign, &magnitude) || magnitude > INT64_MAX)
+        return convertInt64(str, out);
+
+    *out = *str == '-' ? -(int64_t)magnitude : (int64_t)magnitude;
+
+    return true;
+}
+
+static bool convertUint64Fast(const char *str, uint64_t *out) {
+    size_t sign = *str == '+';
+
+    return parseDigitsSwar(str + sign, strlen(str) - sign, out) || convertUint64(str, out);
+}
+
+/*
+    Lexically normalize a path into 'out' (Go's path.Clean): repeated slashes and '.' elements are dropped,
+    'name/..' pairs are removed and '..' can't climb above the root. Returns the length, never longer than the path.
+*/
+static size_t normalizePath(const char *path, size_t length, char *out) {
+    bool rooted = *path == '/';
+    size_t read = rooted, write = rooted, backtrack = rooted; // Bytes before 'backtrack' can't be removed by '..'
+
+    if(rooted)
+        *out = '/';
+
+    while(read < length) {
+        if(path[read] == '/')
+            read++;
+        else if(path[read] == '.' && (read + 1 == length || path[read + 1] == '/'))
+            read++;
+        else if(path[read] == '.' && path[read + 1] == '.' && (read + 2 == length || path[read + 2] == '/')) {
+            read += 2;
+
+            if(write > backtrack) {
+                for(write--; write > backtrack && out[write] != '/'; write--);
+            }
+            else if(!rooted) {
+                if(write > 0)
+                    out[write++] = '/';
+
+                out[write++] = '.';
+                out[write++] = '.';
+                backtrack = write;
+            }
+        }
+        else {
+            if(write != rooted)
+                out[write++] = '/';
+
+            while(read < length && path[read] != '/')
+                out[write++] = path[read++];
+        }
+    }
+
+    if(write == 0)
+        out[write++] = '.';
+
+    out[write] = '\0';
+
+    return write;
+}
+
+static bool addBulkInvalid(BulkChunk *chunk, size_t index) {
+    if(chunk->invalidCount == chunk->invalidCapacity) {
+        size_t capacity = chunk->invalidCapacity ? chunk->invalidCapacity * 2 : 16;
+        size_t *invalid = realloc(chunk->invalid, capacity * sizeof(size_t));
+
+        if(!invalid) {
+            chunk->outOfMemory = true;
+            return false;
+        }
+
+        chunk->invalid = invalid;
+        chunk->invalidCapacity = capacity;
+    }
+
+    chunk->invalid[chunk->invalidCount++] = index;
+
+    return true;
+}
+
+// First pass for the paths, the bytes each chunk needs to store them
+static void measureBulkChunk(size_t index, void *userData) {
+    BulkConversion *bulk = userData;
+    size_t end = (index + 1) * ELOARG_BULK_CHUNK_SIZE < bulk->count ? (index + 1) * ELOARG_BULK_CHUNK_SIZE : bulk->count;
+
+    for(size_t i = index * ELOARG_BULK_CHUNK_SIZE; i < end; i++)
+        bulk->chunks[index].bytes += strlen(bulk->inputs[i]) + 1;
+}
+
+static void convertBulkChunk(size_t index, void *userData) {
+    BulkConversion *bulk = userData;
+    BulkChunk *chunk = &bulk->chunks[index];
+    size_t end = (index + 1) * ELOARG_BULK_CHUNK_SIZE < bulk->count ? (index + 1) * ELOARG_BULK_CHUNK_SIZE : bulk->count;
+    char *strings = bulk->array->strings + chunk->offset;
+
+    for(size_t i = index * ELOARG_BULK_CHUNK_SIZE; i < end; i++) {
+        const char *input = bulk->inputs[i];
+        EloArgValue value = { 0 };
+        bool valid;
+
+        if(bulk->type == ARG_TYPE_PATH) {
+            size_t length = strlen(input);
+
+            // An empty path is the only invalid one
+            if((valid = length > 0)) {
+                ((char **)bulk->array->values)[i] = strings;
+                strings += normalizePath(input, length, strings) + 1;
+            }
+        }
+        else {
+            if(bulk->type == ARG_TYPE_INT64)
+                valid = convertInt64Fast(input, &value.i64);
+            else if(bulk->type == ARG_TYPE_UINT64)
+                valid = convertUint64Fast(input, &value.u64);
+            else
+                valid = convertValue(input, bulk->type, &value);
+
+            ((EloArgValue *)bulk->array->values)[i] = value;
+        }
+
+        if(!valid && !addBulkInvalid(chunk, i))
+            return;
+    }
+}
+
+static void runBulkTasks(BulkConversion *bulk, size_t chunkCount, ThreadPoolTask task) {
+    ThreadPool *threadPool = chunkCount > 1 ? parseThreadPool(0) : NULL;
+
+    if(threadPool)
+        threadPool->run(threadPool, chunkCount, task, bulk);
+    else
+        for(size_t i = 0; i < chunkCount; i++)
+            task(i, bulk);
+}
+
+/*
+    Convert every positional argument (ELOARG_POSITIONAL_ID) or every command line value of a repeated option
+    to an array of the given type. Chunks of the values are converted on the thread pool and the invalid
+    elements are reported by index. Returns false if any element is invalid.
+*/
+static bool eloArgConvertAll(EloArgId id, ArgDataType type, EloArgArray *array) {
+    const char **inputs;
+    size_t count = 0;
+
+    if(!array)
+        error("You must set the array to convert the values into.");
+    else if(type == ARG_TYPE_STRING || type == ARG_TYPE_BOOL || type == ARG_TYPE_COUNT)
+        error("Values can't be converted in bulk to this type.");
+    else if(id != ELOARG_POSITIONAL_ID && (id >= eloarg.count || !takesValue(eloarg.options[id])))
+        error("Cannot convert the values of option id %u, it doesn't take a value.", id);
+
+    memset(array, 0, sizeof(EloArgArray));
+
+    if(id == ELOARG_POSITIONAL_ID) {
+        inputs = (const char **)eloarg.positionalArgs;
+        count = eloarg.positionalCount;
+    }
+    else {
+        // Every occurrence of the option is in the event log
+        if(!(inputs = malloc((eloarg.eventCount ? eloarg.eventCount : 1) * sizeof(char *))))
+            memAllocError("option values");
+
+        for(size_t i = 0; i < eloarg.eventCount; i++)
+            if(eloarg.eventLog[i].id == id && eloarg.eventLog[i].value)
+                inputs[count++] = eloarg.eventLog[i].value;
+    }
+
+    size_t chunkCount = (count + ELOARG_BULK_CHUNK_SIZE - 1) / ELOARG_BULK_CHUNK_SIZE;
+    BulkConversion bulk = { inputs, count, type, array, calloc(chunkCount ? chunkCount : 1, sizeof(BulkChunk)) };
+
+    array->count = count;
+    array->values = calloc(count ? count : 1, sizeof(EloArgValue)); // Same size as a pointer
+
+    if(!bulk.chunks || !array->values)
+        memAllocError("converted values");
+
+    if(type == ARG_TYPE_PATH) {
+        size_t bytes = 0;
+
+        runBulkTasks(&bulk, chunkCount, measureBulkChunk);
+
+        for(size_t i = 0; i < chunkCount; i++) {
+            bulk.chunks[i].offset = bytes;
+            bytes += bulk.chunks[i].bytes;
+        }
+
+        if(!(array->strings = malloc(bytes ? bytes : 1)))
+            memAllocError("normalized paths");
+    }
+
+    runBulkTasks(&bulk, chunkCount, convertBulkChunk);
+
+    // Gather the invalid indices, ascending since the chunks are in order
+    for(size_t i = 0; i < chunkCount; i++)
+        array->invalidCount += bulk.chunks[i].invalidCount;
+
+    if(array->invalidCount && !(array->invalid = malloc(array->invalidCount * sizeof(size_t))))
+        memAllocError("invalid value indices");
+
+    for(size_t i = 0, offset = 0; i < chunkCount; i++) {
+        if(bulk.chunks[i].outOfMemory)
+            memAllocError("invalid value indices");
+
+        if(bulk.chunks[i].invalidCount)
+            memcpy(array->invalid + offset, bulk.chunks[i].invalid, bulk.chunks[i].invalidCount * sizeof(size_t));
+
+        offset += bulk.chunks[i].invalidCount;
+        FREE(bulk.chunks[i].invalid);
+    }
+
+    FREE(bulk.chunks);
+
+    if(id != ELOARG_POSITIONAL_ID)
+        FREE(inputs);
+
+    return array->invalidCount == 0;
+}
+
+static void eloArgFreeArray(EloArgArray *array) {
+    if(!array)
+        return;
+
+    FREE(array->values);
+    FREE(array->invalid);
+    FREE(array->strings);
+    array->count = 0;
+    array->invalidCount = 0;
+}
+
+// Slot of an overridden option, -1 if the overlay falls through to the base
+static int overlaySlot(const EloArgOverlay *overlay, EloArgId id) {
+    if(!(overlay->mask & (UINT64_C(1) << (id & 63))))
+        return -1;
+
+    for(uint32_t i = 0; i < overlay->count; i++)
+        if(overlay->ids[i] == id)
+            return i;
+
+    return -1;
+}
+
+static bool eloArgOverlaySet(EloArgOverlay *overlay, EloArgId id, const char *value) {
+    if(id >= eloarg.count || !value)
+        return false;
+
+    EloArgOption *option = eloarg.options[id];
+    EloArgValue typed = { 0 };
+    int slot = overlaySlot(overlay, id);
+
+    if(option->dataType != ARG_TYPE_STRING && !convertValue(value, option->dataType, &typed))
+        return false;
+
+    if(slot < 0) {
+        if(overlay->count == ELOARG_OVERLAY_CAPACITY)
+            return false;
+
+        slot = overlay->count++;
+        overlay->ids[slot] = id;
+        overlay->mask |= UINT64_C(1) << (id & 63);
+    }
+
+    overlay->values[slot] = value;
+    overlay->typed[slot] = typed;
+
+    return true;
+}
+
+static const char *eloArgOverlayGet(const EloArgOverlay *overlay, EloArgId id) {
+    int slot = overlaySlot(overlay, id);
+
+    return slot < 0 ? eloArgGetId(id) : overlay->values[slot];
+}
+
+// Typed value of the override, or the runtime value of the base option
+static EloArgValue eloArgOverlayValue(const EloArgOverlay *overlay, EloArgId id) {
+    int slot = overlaySlot(overlay, id);
+
+    return slot < 0 ? eloArgGetRuntime(id) : overlay->typed[slot];
+}
+
+static bool eloArgAnyProvided(const uint64_t *mask, size_t words) {
+    size_t ownWords = ELOARG_MASK_WORDS(eloarg.count);
+
+    for(size_t word = 0; word < words && word < ownWords; word++)
+        if(mask[word] & eloarg.providedMask[word])
+            return true;
+
+    return false;
+}
+
+static bool eloArgAllProvided(const uint64_t *mask, size_t words) {
+    size_t ownWords = ELOARG_MASK_WORDS(eloarg.count);
+
+    for(size_t word = 0; word < words; word++)
+        if(mask[word] & ~(word < ownWords ? eloarg.providedMask[word] : 0))
+            return false;
+
+    return true;
+}
+
+static size_t eloArgCountProvided(const uint64_t *mask, size_t words) {
+    size_t ownWords = ELOARG_MASK_WORDS(eloarg.count), count = 0;
+
+    for(size_t word = 0; word < words && word < ownWords; word++)
+        count += __builtin_popcountll(mask[word] & eloarg.providedMask[word]);
+
+    return count;
+}
+
+static void eloArgFree() {
+    if(!eloarg.hashTable)
+        return;
+
+    if(eloarg.watching) {
+        if(write(eloarg.watchStopFds[1], "", 1) == 1)
+            pthread_join(eloarg.watcher, NULL);
+
+        close(eloarg.watchStopFds[0]);
+        close(eloarg.watchStopFds[1]);
+        eloarg.watching = false;
+    }
+
+    if(eloarg.watchFd >= 0) {
+        close(eloarg.watchFd);
+        eloarg.watchFd = -1;
+    }
+
+    if(eloarg.threadPool)
+        eloarg.threadPool->free(&eloarg.threadPool);
+
+    FREE(eloarg.snapshot); // No reader may hold it anymore
+    eloarg.snapshotGeneration = 0;
+    FREE(eloarg.watchPath);
+    FREE(eloarg.configValues);
+    FREE(eloarg.configBuffer);
+    eloarg.configValueCount = 0;
+
+    // Free the EloArgOptions backwards, a table block goes with its first option after the others were checked
+    for(uint32_t i = eloarg.count; i-- > 0;) {
+        FREE(eloarg.options[i]->ownedValue);
+
+        if(eloarg.options[i]->block == eloarg.options[i])
+            free(eloarg.options[i]);
+    }
+
+    eloarg.hashTable->free(&eloarg.hashTable);
+
+    if(eloarg.responseCache) {
+        HashTable *cache = eloarg.responseCache;
+
+        for(size_t i = 0; i < cache->getSize(cache); i++)
+            if(cache->table[i] && cache->table[i]->occupied)
+                freeResponseFile((ResponseFile *)cache->table[i]->value);
+
+        cache->free(&eloarg.responseCache);
+    }
+
+    for(size_t i = 0; i < eloarg.fileBuffers.count; i++)
+        FREE(eloarg.fileBuffers.items[i]);
+
+    FREE(eloarg.fileBuffers.items);
+    eloarg.fileBuffers.count = 0;
+    eloarg.fileBuffers.capacity = 0;
+
+    if(eloarg.environmentIndex)
+        eloarg.environmentIndex->free(&eloarg.environmentIndex);
+
+    FREE(eloarg.environmentNames);
+    FREE(eloarg.environmentPrefix);
+    eloarg.environmentIndexedCount = 0;
+
+    FREE(eloarg.options);
+    FREE(eloarg.providedMask);
+    FREE(eloarg.requiredMask);
+    FREE(eloarg.defaultMask);
+    FREE(eloarg.expandedArgs);
+    FREE(eloarg.positionalArgs);
+    FREE(eloarg.eventLog);
+    eloarg.eventCount = 0;
+    eloarg.eventCapacity = 0;
+    eloarg.positionalCount = 0;
+    eloarg.restArgs = NULL;
+    eloarg.restCount = 0;
+    memset(eloarg.shortOptions, 0, sizeof(eloarg.shortOptions));
+    eloarg.capacity = 0;
+    eloarg.count = 0;
 }
 
 EloArg *eloArgInit(size_t size) {
     eloarg.hashTable = initHashTable(size * 3); // Avoid hash table resizing
+    eloarg.options = size > 0 ? malloc(size * sizeof(EloArgOption *)) : NULL;
+    eloarg.capacity = eloarg.options ? size : 0;
+    eloarg.providedMask = NULL;
+    eloarg.requiredMask = NULL;
+    eloarg.defaultMask = NULL;
+
+    if(!growOptionMasks(0, eloarg.capacity))
+        memAllocError("option bitsets");
+    memset(eloarg.shortOptions, 0, sizeof(eloarg.shortOptions));
     eloarg.count = 0;
+    eloarg.positionalArgs = NULL;
+    eloarg.positionalCount = 0;
+    eloarg.restArgs = NULL;
+    eloarg.restCount = 0;
+    eloarg.eventLog = NULL;
+    eloarg.eventCount = 0;
+    eloarg.eventCapacity = 0;
+    eloarg.responseFilesEnabled = false;
+    eloarg.expandedArgs = NULL;
+    eloarg.responseCache = NULL;
+    eloarg.parseGeneration = 0;
+    eloarg.fileBuffers = (ArgVector){ NULL, 0, 0 };
+    eloarg.environmentPrefix = NULL;
+    eloarg.environmentIndex = NULL;
+    eloarg.environmentNames = NULL;
+    eloarg.environmentIndexedCount = 0;
+    eloarg.configValues = NULL;
+    eloarg.configValueCount = 0;
+    eloarg.configBuffer = NULL;
+    eloarg.watchPath = NULL;
+    eloarg.watchFd = -1;
+    eloarg.watching = false;
+    eloarg.onConfigChange = NULL;
+    eloarg.configChangeUserData = NULL;
+    eloarg.threadPool = NULL;
+    eloarg.resolver = NULL;
+    eloarg.helpLines = NULL;
+    eloarg.helpFirst = 0;
+    eloarg.helpCount = 0;
+    eloarg.snapshot = NULL;
+    eloarg.snapshotGeneration = 0;
+    eloarg.snapshotPhase = 0;
+    eloarg.snapshotReaders[0].count = 0;
+    eloarg.snapshotReaders[1].count = 0;
+    pthread_mutex_init(&eloarg.publishMutex, NULL);
     eloarg.help = printHelp;
     eloarg.add = eloArgAdd;
+    eloarg.addTable = eloArgAddTable;
+    eloarg.setResolver = eloArgSetResolver;
+    eloarg.setHelp = eloArgSetHelp;
+    eloarg.bind = eloArgBind;
+    eloarg.bindStruct = eloArgBindStruct;
     eloarg.parse = eloArgParse;
+    eloarg.parseParallel = eloArgParseParallel;
+    eloarg.stream = eloArgStream;
+    eloarg.parseFd = eloArgParseFd;
+    eloarg.parseBuffer = eloArgParseBuffer;
+    eloarg.publish = eloArgPublish;
+    eloarg.acquire = eloArgAcquire;
+    eloarg.release = eloArgRelease;
+    eloarg.responseFiles = eloArgResponseFiles;
+    eloarg.envPrefix = eloArgEnvPrefix;
+    eloarg.loadConfig = eloArgLoadConfig;
+    eloarg.watchConfig = eloArgWatchConfig;
+    eloarg.setDefault = eloArgSetDefault;
     eloarg.has = eloArgHas;
     eloarg.get = eloArgGet;
     eloarg.getCount = eloArgCount;
+    eloarg.positionals = eloArgPositionals;
+    eloarg.rest = eloArgRest;
+    eloarg.events = eloArgEvents;
+    eloarg.hasId = eloArgHasId;
+    eloarg.anyProvided = eloArgAnyProvided;
+    eloarg.allProvided = eloArgAllProvided;
+    eloarg.countProvided = eloArgCountProvided;
+    eloarg.getId = eloArgGetId;
+    eloarg.countId = eloArgCountId;
+    eloarg.idOf = eloArgIdOf;
+    eloarg.setType = eloArgSetType;
+    eloarg.getInt64 = eloArgGetInt64;
+    eloarg.getUint64 = eloArgGetUint64;
+    eloarg.getDouble = eloArgGetDouble;
+    eloarg.getBool = eloArgGetBool;
+    eloarg.getSize = eloArgGetSize;
+    eloarg.getDuration = eloArgGetDuration;
+    eloarg.setRuntime = eloArgSetRuntime;
+    eloarg.getRuntime = eloArgGetRuntime;
+    eloarg.runtimeCell = eloArgRuntimeCell;
+    eloarg.convertAll = eloArgConvertAll;
+    eloarg.freeArray = eloArgFreeArray;
+    eloarg.overlaySet = eloArgOverlaySet;
+    eloarg.overlayGet = eloArgOverlayGet;
+    eloarg.overlayValue = eloArgOverlayValue;
     eloarg.free = eloArgFree;
 
     return &eloarg;
@@ -2,15 +2,29 @@
 #define ELOARG_H
 
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <pthread.h>
 
 #include "hashtable.h"
+#include "threadpool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 #define ELOARG_SHORT_OPTION_LENGTH 1
 #define ELOARG_LONG_OPTION_LENGTH 32
 #define ELOARG_DESCRIPTION_LENGTH 150
-#define ELOARG_UNIQUE_STR_ID 12
+#define ELOARG_FD_BUFFER_SIZE 65536
+#define ELOARG_PARALLEL_CHUNK_SIZE 16384 // Minimum arguments per chunk of parseParallel
+#define ELOARG_INVALID_ID UINT32_MAX
+#define ELOARG_POSITIONAL_ID ELOARG_INVALID_ID // Event id of positional arguments
+
+// Bitsets of options indexed by EloArgId (anyProvided, allProvided)
+#define ELOARG_MASK_WORDS(count) (((size_t)(count) + 63) / 64)
+#define ELOARG_MASK_SET(mask, id) ((mask)[(id) / 64] |= UINT64_C(1) << ((id) % 64))
 
 #define FREE(ptr) do {  \
     if(ptr) {   \
@@ -26,38 +40,326 @@ typedef enum {
     ARG_REQUIRED
 } ArgValueType;
 
+typedef enum {
+    ARG_TYPE_STRING,   // const char *, owned by EloArg
+    ARG_TYPE_BOOL,     // bool, true once the flag is provided or parsed from true/false, yes/no, on/off, 1/0
+    ARG_TYPE_COUNT,    // size_t, number of occurrences
+    ARG_TYPE_INT64,    // int64_t
+    ARG_TYPE_UINT64,   // uint64_t
+    ARG_TYPE_DOUBLE,   // double
+    ARG_TYPE_SIZE,     // uint64_t, bytes (4GiB, 512K, 2MB)
+    ARG_TYPE_DURATION, // uint64_t, nanoseconds (30s, 250ms, 1h30m)
+    ARG_TYPE_PATH      // char *, lexically normalized path (a//b/../c -> a/c), convertAll only
+} ArgDataType;
+
+// Where the value of an option comes from, higher sources take precedence
+typedef enum {
+    ARG_SOURCE_NONE,
+    ARG_SOURCE_DEFAULT,
+    ARG_SOURCE_FILE,
+    ARG_SOURCE_ENV,
+    ARG_SOURCE_ARGV
+} ArgSource;
+
+typedef union {
+    int64_t i64;
+    uint64_t u64; // Also holds sizes and durations
+    double f64;
+    bool boolean;
+} EloArgValue;
+
+#define ELOARG_CACHE_LINE_SIZE 64
+
+// Runtime value of a typed option, alone on its cache line so readers of one flag don't share a line with another
+typedef struct {
+    uint64_t bits; // EloArgValue bits, published with a release store
+} __attribute__((aligned(ELOARG_CACHE_LINE_SIZE))) EloArgCell;
+
+// Lock-free read of a runtime cell, for hot paths holding the pointer returned by runtimeCell
+static inline EloArgValue eloArgLoadCell(const EloArgCell *cell) {
+    EloArgValue value;
+
+    value.u64 = __atomic_load_n(&cell->bits, __ATOMIC_ACQUIRE);
+
+    return value;
+}
+
+typedef uint32_t EloArgId; // Index of an option in the dense option array
+
+// Compile-time option descriptor, see ELOARG_OPTION_TABLE
+typedef struct {
+    const char *shortOption; // NULL if the option has no short form
+    const char *longOption; // NULL if the option has no long form
+    const char *description;
+    ArgValueType valueType;
+    ArgDataType dataType;
+} EloArgSpec;
+
+// X-macro option lists, each entry is X(id, shortOption, longOption, description, valueType, dataType)
+#define ELOARG_SPEC_ID(id, shortOption, longOption, description, valueType, dataType) id,
+#define ELOARG_SPEC_ENTRY(id, shortOption, longOption, description, valueType, dataType) \
+    { (shortOption), (longOption), (description), (valueType), (dataType) },
+
+// Expands a list to an enum of option ids followed by name##Count
+#define ELOARG_OPTION_IDS(name, LIST) typedef enum { LIST(ELOARG_SPEC_ID) name##Count } name;
+
+// Expands a list to a static const EloArgSpec array in rodata, registered with addTable
+#define ELOARG_OPTION_TABLE(name, LIST) static const EloArgSpec name[] = { LIST(ELOARG_SPEC_ENTRY) };
+
 typedef struct {
-    char shortOption[ELOARG_SHORT_OPTION_LENGTH + 1];
-    char longOption[ELOARG_LONG_OPTION_LENGTH + 1];
-    char description[ELOARG_DESCRIPTION_LENGTH + 1];
+    const char *shortOption; // "" when absent, points into the option block or into an EloArgSpec
+    const char *longOption;
+    const char *description;
     ArgValueType valueType;
-    char uniqueStrId[ELOARG_UNIQUE_STR_ID];
-    char *value;
+    EloArgId id;
+    const char *value; // Points into argv or a response or config file buffer
+    char *ownedValue; // Copy of the last value read by parseFd, freed when replaced
+    ArgSource source;
+    const char *defaultValue;
+    void *binding; // Destination written by parse, NULL if unbound
+    ArgDataType bindType;
+    ArgDataType dataType; // Converted at parse time unless ARG_TYPE_STRING
+    EloArgValue cache; // Last conversion of value
+    ArgDataType cacheType;
+    bool cached;
     bool provided;
     size_t count;
-    uint8_t refCount;
+    void *block; // Allocation holding the option, addTable allocates one block for the whole table
+    EloArgCell runtime; // Typed value read by other threads, see setRuntime
 } EloArgOption;
 
+typedef struct {
+    char **items;
+    size_t count;
+    size_t capacity;
+} ArgVector;
+
+// One parsed token, events are kept in argv order
+typedef struct {
+    EloArgId id; // ELOARG_POSITIONAL_ID for positional arguments
+    const char *value; // Points into argv, NULL for flags
+    size_t index; // Index of the option in argv
+} EloArgEvent;
+
+// Result of parseBuffer, one per option indexed by EloArgId
+typedef struct {
+    const char *value; // Last value, points into the buffer
+    uint32_t length;
+    uint32_t count; // Occurrences, 0 if the option wasn't provided
+} EloArgMatch;
+
+// Immutable result of publish, shared by the reader threads
+typedef struct {
+    const EloArgMatch *matches; // One per option indexed by EloArgId, values point into the snapshot
+    const char *const *positionals;
+    size_t positionalCount;
+    const char *const *rest; // Arguments after '--', follow the positionals
+    size_t restCount;
+    uint64_t generation; // 1 for the first published snapshot
+    uint32_t count; // Options registered when it was published
+} EloArgSnapshot;
+
+// Reader reference returned by acquire, handed back to release
+typedef struct {
+    const EloArgSnapshot *snapshot; // NULL before the first publish
+    uint32_t phase;
+} EloArgSnapshotRef;
+
+#define ELOARG_OVERLAY_CAPACITY 8
+
+// Request-scoped overrides on top of the parsed options, lives on the stack and never allocates
+typedef struct {
+    uint64_t mask; // Bit (id % 64) of every overridden option, skips the search for the others
+    uint32_t count;
+    EloArgId ids[ELOARG_OVERLAY_CAPACITY];
+    const char *values[ELOARG_OVERLAY_CAPACITY]; // Not copied, must outlive the overlay
+    EloArgValue typed[ELOARG_OVERLAY_CAPACITY]; // Converted with the type of the option
+} EloArgOverlay;
+
+#define ELOARG_OVERLAY_INIT { 0 }
+
+#define ELOARG_BULK_CHUNK_SIZE 4096 // Elements per task of convertAll
+
+// Result of convertAll, released with freeArray
+typedef struct {
+    void *values; // int64_t, uint64_t or double per element, char * for ARG_TYPE_PATH. 0 or NULL where invalid.
+    size_t count;
+    size_t *invalid; // Indices of the elements that failed to convert, ascending
+    size_t invalidCount;
+    char *strings; // Storage of the normalized paths
+} EloArgArray;
+
+// Streaming handlers, return false to stop parsing. Values point into argv, NULL for flags.
+typedef bool (*EloArgOptionHandler)(EloArgId id, const char *value, size_t index, void *userData);
+typedef bool (*EloArgPositionalHandler)(const char *argument, size_t index, void *userData);
+
+// Maps a long option name (not NUL-terminated) to its handle, ELOARG_INVALID_ID if unknown. Generated by eloarg-gen.
+typedef EloArgId (*EloArgResolver)(const char *name, size_t length);
+
+// Config file change handler, runs on the watcher thread. Values are NULL when absent, "" for flags,
+// and only valid until the handler returns.
+typedef void (*EloArgChangeHandler)(EloArgId id, const char *oldValue, const char *newValue, void *userData);
+
+typedef struct {
+    const char *key;
+    ArgDataType type;
+    size_t offset; // offsetof() the destination field in the bound struct
+} EloArgBinding;
+
+#define ELOARG_BINDING(structType, member, key, type) { (key), (type), offsetof(structType, member) }
+
 typedef struct EloArg {
     HashTable *hashTable;
+    EloArgOption **options; // Dense option array indexed by EloArgId
+    EloArgOption *shortOptions[UINT8_MAX + 1]; // Short options indexed by their byte
+    uint32_t capacity;
     uint32_t count;
+    uint64_t *providedMask; // Bitsets indexed by EloArgId, sized for the capacity
+    uint64_t *requiredMask;
+    uint64_t *defaultMask;
+    char **positionalArgs; // Pointers into argv, allocated once per parse
+    size_t positionalCount;
+    char **restArgs; // Slice of argv after '--'
+    size_t restCount;
+    EloArgEvent *eventLog; // Every option and positional in argv order
+    size_t eventCount;
+    size_t eventCapacity;
+    bool responseFilesEnabled; // Expand '@file' arguments
+    char **expandedArgs; // argv with the response files expanded
+    HashTable *responseCache; // Tokenized response files by path
+    uint32_t parseGeneration;
+    ArgVector fileBuffers; // Response and config files read into memory, the values point into them
+    char *environmentPrefix; // Environment variable fallback, NULL if disabled
+    HashTable *environmentIndex; // Environment variable names to options
+    char *environmentNames;
+    uint32_t environmentIndexedCount;
+    const char **configValues; // Last value of each option in the watched config file
+    char *configBuffer; // Buffer of the last reload, configValues point into it
+    uint32_t configValueCount;
+    char *watchPath;
+    pthread_t watcher;
+    int watchFd;
+    int watchStopFds[2];
+    bool watching;
+    EloArgChangeHandler onConfigChange;
+    void *configChangeUserData;
+    EloArgSnapshot *snapshot; // Current snapshot, swapped by publish
+    uint64_t snapshotGeneration;
+    uint32_t snapshotPhase; // Readers register in the counter of the current phase
+    struct {
+        size_t count;
+    } __attribute__((aligned(64))) snapshotReaders[2]; // One cache line each
+    pthread_mutex_t publishMutex; // Serializes the writers, readers never take it
+    ThreadPool *threadPool; // Created by the first parallel parse
+    EloArgResolver resolver; // Looks up the long options while scanning, NULL for the hash table
+    const char *helpLines; // Precomputed help of the options from helpFirst, NULL to format them all
+    EloArgId helpFirst;
+    size_t helpCount;
 
     void (*help)(const char *description, const char *footerDescription);
-    void (*add)(char *shortOption, char *longOption, char *description, ArgValueType valueType);
+    EloArgId (*add)(char *shortOption, char *longOption, char *description, ArgValueType valueType);
+    EloArgId (*addTable)(const EloArgSpec *specs, size_t count);
+    void (*setResolver)(EloArgResolver resolver);
+    void (*setHelp)(EloArgId first, size_t count, const char *lines);
+    void (*bind)(const char *key, ArgDataType type, void *destination);
+    void (*bindStruct)(void *base, const EloArgBinding *bindings, size_t count);
     void (*parse)(int argc, char **argv);
+    void (*parseParallel)(int argc, char **argv, size_t threads);
+    void (*responseFiles)(bool enabled);
+    void (*envPrefix)(const char *prefix);
+    void (*loadConfig)(const char *path);
+    void (*watchConfig)(const char *path, EloArgChangeHandler onChange, void *userData);
+    void (*setDefault)(EloArgId id, const char *value);
+    void (*parseFd)(int fd, char delimiter, EloArgPositionalHandler onPositional, void *userData);
+    bool (*parseBuffer)(const char *buffer, size_t length, EloArgMatch *matches);
+    bool (*publish)(int argc, char **argv);
+    EloArgSnapshotRef (*acquire)();
+    void (*release)(EloArgSnapshotRef ref);
+    void (*stream)(int argc, char **argv, EloArgOptionHandler onOption, EloArgPositionalHandler onPositional, void *userData);
     bool (*has)(const char *key);
     const char *(*get)(const char *key);
     size_t (*getCount)(const char *key);
+    char **(*positionals)(size_t *count);
+    char **(*rest)(size_t *count);
+    const EloArgEvent *(*events)(size_t *count);
+    bool (*hasId)(EloArgId id);
+    bool (*anyProvided)(const uint64_t *mask, size_t words);
+    bool (*allProvided)(const uint64_t *mask, size_t words);
+    size_t (*countProvided)(const uint64_t *mask, size_t words);
+    const char *(*getId)(EloArgId id);
+    size_t (*countId)(EloArgId id);
+    EloArgId (*idOf)(const char *key);
+    void (*setType)(EloArgId id, ArgDataType type);
+    int64_t (*getInt64)(EloArgId id);
+    uint64_t (*getUint64)(EloArgId id);
+    double (*getDouble)(EloArgId id);
+    bool (*getBool)(EloArgId id);
+    uint64_t (*getSize)(EloArgId id);
+    uint64_t (*getDuration)(EloArgId id);
+    bool (*setRuntime)(const char *key, const char *value);
+    EloArgValue (*getRuntime)(EloArgId id);
+    const EloArgCell *(*runtimeCell)(EloArgId id);
+    bool (*convertAll)(EloArgId id, ArgDataType type, EloArgArray *array);
+    void (*freeArray)(EloArgArray *array);
+    bool (*overlaySet)(EloArgOverlay *overlay, EloArgId id, const char *value);
+    const char *(*overlayGet)(const EloArgOverlay *overlay, EloArgId id);
+    EloArgValue (*overlayValue)(const EloArgOverlay *overlay, EloArgId id);
     void (*free)();
 } EloArg;
 
 static void printHelp(const char *description, const char *footerDescription);
-static void eloArgAdd(char *shortOption, char *longOption, char *description, ArgValueType valueType);
+static EloArgId eloArgAdd(char *shortOption, char *longOption, char *description, ArgValueType valueType);
+static EloArgId eloArgAddTable(const EloArgSpec *specs, size_t count);
+static void eloArgSetResolver(EloArgResolver resolver);
+static void eloArgSetHelp(EloArgId first, size_t count, const char *lines);
+static void eloArgBind(const char *key, ArgDataType type, void *destination);
+static void eloArgBindStruct(void *base, const EloArgBinding *bindings, size_t count);
 static void eloArgParse(int argc, char **argv);
+static void eloArgParseParallel(int argc, char **argv, size_t threads);
+static void eloArgResponseFiles(bool enabled);
+static void eloArgEnvPrefix(const char *prefix);
+static void eloArgLoadConfig(const char *path);
+static void eloArgWatchConfig(const char *path, EloArgChangeHandler onChange, void *userData);
+static void eloArgSetDefault(EloArgId id, const char *value);
+static void eloArgParseFd(int fd, char delimiter, EloArgPositionalHandler onPositional, void *userData);
+static bool eloArgParseBuffer(const char *buffer, size_t length, EloArgMatch *matches);
+static bool eloArgPublish(int argc, char **argv);
+static EloArgSnapshotRef eloArgAcquire();
+static void eloArgRelease(EloArgSnapshotRef ref);
+static void eloArgStream(int argc, char **argv, EloArgOptionHandler onOption, EloArgPositionalHandler onPositional, void *userData);
 static bool eloArgHas(const char *key);
 static const char *eloArgGet(const char *key);
 static size_t eloArgCount(const char *key);
+static char **eloArgPositionals(size_t *count);
+static char **eloArgRest(size_t *count);
+static const EloArgEvent *eloArgEvents(size_t *count);
+static bool eloArgHasId(EloArgId id);
+static bool eloArgAnyProvided(const uint64_t *mask, size_t words);
+static bool eloArgAllProvided(const uint64_t *mask, size_t words);
+static size_t eloArgCountProvided(const uint64_t *mask, size_t words);
+static const char *eloArgGetId(EloArgId id);
+static size_t eloArgCountId(EloArgId id);
+static EloArgId eloArgIdOf(const char *key);
+static void eloArgSetType(EloArgId id, ArgDataType type);
+static int64_t eloArgGetInt64(EloArgId id);
+static uint64_t eloArgGetUint64(EloArgId id);
+static double eloArgGetDouble(EloArgId id);
+static bool eloArgGetBool(EloArgId id);
+static uint64_t eloArgGetSize(EloArgId id);
+static uint64_t eloArgGetDuration(EloArgId id);
+static bool eloArgSetRuntime(const char *key, const char *value);
+static EloArgValue eloArgGetRuntime(EloArgId id);
+static const EloArgCell *eloArgRuntimeCell(EloArgId id);
+static bool eloArgConvertAll(EloArgId id, ArgDataType type, EloArgArray *array);
+static void eloArgFreeArray(EloArgArray *array);
+static bool eloArgOverlaySet(EloArgOverlay *overlay, EloArgId id, const char *value);
+static const char *eloArgOverlayGet(const EloArgOverlay *overlay, EloArgId id);
+static EloArgValue eloArgOverlayValue(const EloArgOverlay *overlay, EloArgId id);
 static void eloArgFree();
 EloArg *eloArgInit(size_t size);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
\ No newline at end of file
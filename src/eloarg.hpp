@@ -0,0 +1,375 @@
+/*
+    EloArg C++ Interface
+
+    Description:
+    C++17 layer over the C library. Options are declared as a `constexpr` table of `EloArgSpec`,
+    the same descriptors `addTable` takes, along with an enum naming them in table order.
+    At compile time the table gives a perfect hash of the long options, installed as the resolver,
+    and the type of each option. `parse` converts every value once into an array of typed slots,
+    so `get<Opt::port>()` is a load at a constant offset.
+
+    Example:
+        inline constexpr EloArgSpec specs[] = {
+            { "p", "port", "Port to listen on.", ARG_REQUIRED, ARG_TYPE_INT64 },
+            { NULL, "host", "Host to bind.", ARG_OPTIONAL, ARG_TYPE_STRING },
+            { "v", "verbose", "Increase verbosity level.", ARG_NONE, ARG_TYPE_COUNT },
+        };
+
+        enum class Opt { port, host, verbose };
+
+        eloarg::Parser<specs, Opt> args;
+
+        args.parse(argc, argv);
+
+        int64_t port = args.get<Opt::port>();
+        std::string_view host = args.get<Opt::host>(); // Points into argv
+        size_t verbosity = args.get<Opt::verbose>();
+
+    Types:
+    - `ARG_TYPE_STRING`: `std::string_view`, empty when the option is absent.
+    - `ARG_TYPE_BOOL`: `bool`.
+    - `ARG_TYPE_COUNT`: `size_t`, occurrences of the option.
+    - `ARG_TYPE_INT64`: `int64_t`.
+    - `ARG_TYPE_UINT64`, `ARG_TYPE_SIZE`, `ARG_TYPE_DURATION`: `uint64_t`.
+    - `ARG_TYPE_DOUBLE`: `double`.
+
+    Notes:
+    - EloArg keeps its state in one global instance, so only one `Parser` may live at a time.
+    - The C API stays reachable through `operator->`, e.g. `args->envPrefix("APP_")` before `parse`.
+*/
+
+#ifndef ELOARG_HPP
+#define ELOARG_HPP
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "eloarg.h"
+
+namespace eloarg {
+
+// C++ type of an option value
+template<ArgDataType Type>
+struct ValueOf {
+    using type = std::string_view;
+};
+
+template<> struct ValueOf<ARG_TYPE_BOOL> { using type = bool; };
+template<> struct ValueOf<ARG_TYPE_COUNT> { using type = std::size_t; };
+template<> struct ValueOf<ARG_TYPE_INT64> { using type = std::int64_t; };
+template<> struct ValueOf<ARG_TYPE_UINT64> { using type = std::uint64_t; };
+template<> struct ValueOf<ARG_TYPE_DOUBLE> { using type = double; };
+template<> struct ValueOf<ARG_TYPE_SIZE> { using type = std::uint64_t; };
+template<> struct ValueOf<ARG_TYPE_DURATION> { using type = std::uint64_t; };
+
+template<ArgDataType Type>
+using ValueType = typename ValueOf<Type>::type;
+
+// Converted value of one option, the type is known from the table at compile time
+union Value {
+    std::string_view string;
+    bool boolean;
+    std::size_t count;
+    std::int64_t i64;
+    std::uint64_t u64;
+    double f64;
+
+    constexpr Value() : u64(0) {}
+};
+
+namespace detail {
+
+constexpr std::size_t length(const char *str) {
+    return str ? std::char_traits<char>::length(str) : 0;
+}
+
+// 64-bit FNV-1a, the key is hashed once and the seeds only remix the hash
+constexpr std::uint64_t fnv1a(const char *key, std::size_t length) {
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for(std::size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(key[i]);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+// Finalizer of MurmurHash3
+constexpr std::uint64_t mix(std::uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+constexpr std::size_t slotCount(std::size_t count) {
+    std::size_t size = 1;
+
+    while(size < count * 2)
+        size <<= 1;
+
+    return size;
+}
+
+// Hash and displace: the keys are spread over one bucket per key, then each bucket, largest first,
+// gets the first seed moving all of its keys to free slots
+template<std::size_t N>
+struct PerfectHash {
+    static constexpr std::size_t size = slotCount(N);
+    static constexpr std::uint32_t maxSeed = 1u << 16;
+
+    std::array<std::uint32_t, N> seeds{}; // Per bucket
+    std::array<std::uint32_t, size> slots{}; // Table index + 1, 0 when empty
+    bool built = false; // False if two names share their 64-bit hash
+
+    constexpr std::size_t bucket(std::uint64_t hash) const {
+        return mix(hash) % N;
+    }
+
+    constexpr std::size_t slot(std::uint64_t hash, std::uint32_t seed) const {
+        return mix(hash ^ (seed * 0x9e3779b97f4a7c15ull)) & (size - 1);
+    }
+
+    constexpr std::uint32_t find(std::uint64_t hash) const {
+        return slots[slot(hash, seeds[bucket(hash)])];
+    }
+};
+
+template<std::size_t N>
+constexpr PerfectHash<N> buildPerfectHash(const EloArgSpec (&specs)[N]) {
+    PerfectHash<N> table{};
+    std::array<std::uint64_t, N> hashes{};
+    std::array<std::size_t, N + 1> starts{}; // Counting sort of the keys by bucket
+    std::array<std::size_t, N> keys{};
+    std::array<std::size_t, N> fill{};
+    std::size_t largest = 0;
+
+    for(std::size_t i = 0; i < N; i++)
+        if(specs[i].longOption) {
+            hashes[i] = fnv1a(specs[i].longOption, length(specs[i].longOption));
+            starts[table.bucket(hashes[i]) + 1]++;
+        }
+
+    for(std::size_t b = 0; b < N; b++) {
+        largest = starts[b + 1] > largest ? starts[b + 1] : largest;
+        starts[b + 1] += starts[b];
+    }
+
+    for(std::size_t i = 0; i < N; i++)
+        if(specs[i].longOption) {
+            std::size_t b = table.bucket(hashes[i]);
+
+            keys[starts[b] + fill[b]++] = i;
+        }
+
+    for(std::size_t bucketSize = largest; bucketSize > 0; bucketSize--)
+        for(std::size_t b = 0; b < N; b++) {
+            if(starts[b + 1] - starts[b] != bucketSize)
+                continue;
+
+            std::uint32_t seed = 0;
+
+            for(; seed < PerfectHash<N>::maxSeed; seed++) {
+                bool fits = true;
+
+                for(std::size_t k = starts[b]; k < starts[b + 1] && fits; k++) {
+                    std::size_t slot = table.slot(hashes[keys[k]], seed);
+
+                    fits = table.slots[slot] == 0;
+
+                    // Keys of the same bucket must not collide either
+                    for(std::size_t other = starts[b]; other < k && fits; other++)
+                        fits = table.slot(hashes[keys[other]], seed) != slot;
+                }
+
+                if(fits)
+                    break;
+            }
+
+            if(seed == PerfectHash<N>::maxSeed)
+                return table;
+
+            table.seeds[b] = seed;
+
+            for(std::size_t k = starts[b]; k < starts[b + 1]; k++)
+                table.slots[table.slot(hashes[keys[k]], seed)] = static_cast<std::uint32_t>(keys[k] + 1);
+        }
+
+    table.built = true;
+
+    return table;
+}
+
+} // namespace detail
+
+template<const auto &Specs, typename Id>
+class Parser {
+public:
+    static constexpr std::size_t count = std::extent_v<std::remove_reference_t<decltype(Specs)>>;
+
+    static_assert(std::is_enum_v<Id>, "Options are named by an enum in table order.");
+    static_assert(count > 0, "The option table is empty.");
+
+    // Registers the table and the resolver, call parse once the C options are set
+    Parser() : eloarg(eloArgInit(count)) {
+        base = eloarg->addTable(tableSpecs.data(), count);
+        eloarg->setResolver(resolve);
+    }
+
+    ~Parser() {
+        eloarg->free();
+    }
+
+    Parser(const Parser &) = delete;
+    Parser &operator=(const Parser &) = delete;
+
+    // Parses argc and argv like the C parse, then converts every option once
+    void parse(int argc, char **argv) {
+        eloarg->parse(argc, argv);
+
+        for(std::size_t i = 0; i < count; i++)
+            loadValue(i);
+    }
+
+    template<Id id>
+    ValueType<Specs[static_cast<std::size_t>(id)].dataType> get() const {
+        constexpr ArgDataType type = Specs[position(id)].dataType;
+        const Value &value = values[position(id)];
+
+        if constexpr(type == ARG_TYPE_BOOL)
+            return value.boolean;
+        else if constexpr(type == ARG_TYPE_COUNT)
+            return value.count;
+        else if constexpr(type == ARG_TYPE_INT64)
+            return value.i64;
+        else if constexpr(type == ARG_TYPE_DOUBLE)
+            return value.f64;
+        else if constexpr(type == ARG_TYPE_UINT64 || type == ARG_TYPE_SIZE || type == ARG_TYPE_DURATION)
+            return value.u64;
+        else
+            return value.string;
+    }
+
+    template<Id id>
+    bool has() const {
+        return eloarg->hasId(base + position(id));
+    }
+
+    // Handle of an option for the C API
+    template<Id id>
+    EloArgId handle() const {
+        return base + position(id);
+    }
+
+    // Table index of a long option, at compile time when the name is a constant
+    static constexpr EloArgId idOf(std::string_view name) {
+        if(name.empty())
+            return ELOARG_INVALID_ID;
+
+        std::uint32_t entry = perfectHash.find(detail::fnv1a(name.data(), name.size()));
+
+        if(entry == 0 || name != Specs[entry - 1].longOption)
+            return ELOARG_INVALID_ID;
+
+        return entry - 1;
+    }
+
+    EloArg *operator->() const {
+        return eloarg;
+    }
+
+private:
+    static constexpr std::size_t position(Id id) {
+        return static_cast<std::size_t>(id);
+    }
+
+    // Counted options are converted by countId, the C table leaves them untyped
+    static constexpr std::array<EloArgSpec, count> makeTableSpecs() {
+        std::array<EloArgSpec, count> specs{};
+
+        for(std::size_t i = 0; i < count; i++) {
+            specs[i] = Specs[i];
+
+            if(specs[i].dataType == ARG_TYPE_COUNT)
+                specs[i].dataType = ARG_TYPE_STRING;
+        }
+
+        return specs;
+    }
+
+    static constexpr std::array<std::size_t, count> makeLengths() {
+        std::array<std::size_t, count> lengths{};
+
+        for(std::size_t i = 0; i < count; i++)
+            lengths[i] = detail::length(Specs[i].longOption);
+
+        return lengths;
+    }
+
+    static EloArgId resolve(const char *name, size_t length) {
+        std::uint32_t entry = perfectHash.find(detail::fnv1a(name, length));
+
+        if(entry == 0 || lengths[entry - 1] != length || std::memcmp(Specs[entry - 1].longOption, name, length) != 0)
+            return ELOARG_INVALID_ID;
+
+        return base + entry - 1;
+    }
+
+    void loadValue(std::size_t i) {
+        Value &value = values[i];
+        EloArgId id = base + static_cast<EloArgId>(i);
+
+        switch(Specs[i].dataType) {
+            case ARG_TYPE_BOOL:
+                value.boolean = eloarg->getBool(id);
+                break;
+            case ARG_TYPE_COUNT:
+                value.count = eloarg->countId(id);
+                break;
+            case ARG_TYPE_INT64:
+                value.i64 = eloarg->getInt64(id);
+                break;
+            case ARG_TYPE_UINT64:
+                value.u64 = eloarg->getUint64(id);
+                break;
+            case ARG_TYPE_DOUBLE:
+                value.f64 = eloarg->getDouble(id);
+                break;
+            case ARG_TYPE_SIZE:
+                value.u64 = eloarg->getSize(id);
+                break;
+            case ARG_TYPE_DURATION:
+                value.u64 = eloarg->getDuration(id);
+                break;
+            default: {
+                const char *string = eloarg->getId(id);
+
+                value.string = string ? std::string_view(string) : std::string_view();
+                break;
+            }
+        }
+    }
+
+    static constexpr std::array<EloArgSpec, count> tableSpecs = makeTableSpecs();
+    static constexpr std::array<std::size_t, count> lengths = makeLengths();
+    static constexpr detail::PerfectHash<count> perfectHash = detail::buildPerfectHash(Specs);
+
+    static_assert(perfectHash.built, "No perfect hash found for the long options.");
+
+    inline static EloArgId base = 0; // Handle of the first option, the resolver has no instance
+
+    EloArg *eloarg;
+    std::array<Value, count> values{};
+};
+
+} // namespace eloarg
+
+#endif
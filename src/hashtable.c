@@ -31,8 +31,16 @@
         Create a new hash table with a specified initial size.
     - Insertion (`set`):
         Add a key-value pair to the hash table. Automatically handles collisions using linear probing.
+    - Insertion without replacing (`insert`):
+        Same as `set`, but leaves an existing key alone and returns false, a duplicate check in the same probe.
+    - Reservation (`reserve`):
+        Grow the table once ahead of inserting many keys.
     - Retrieval (`get`):
         Retrieve the value associated with a given key.
+    - Retrieval by length (`getN`):
+        Same as `get` for a key that isn't NUL-terminated, such as a slice of a larger string.
+    - Retrieval by hash (`getHashed`):
+        Same as `getN` with the FNV-1a hash of the key computed by the caller, e.g. while tokenizing it.
     - Deletion (`delete`):
         Remove a key-value pair from the hash table.
     - Existence Check (`has`):
@@ -58,16 +66,33 @@ static void memAllocError(const char *err) {
 
 // FNV-1a (Fowler-Noll-Vo) Algorithm
 static uint32_t hash(const char *key, size_t size) {
-    uint32_t hashValue = 2166136261; // FNV offset basis
+    uint32_t hashValue = HASH_FNV_OFFSET_BASIS;
 
     for(size_t i = 0; key[i] != '\0'; i++) {
         hashValue ^= (unsigned char)key[i];
-        hashValue *= 16777619; // FNV prime
+        hashValue *= HASH_FNV_PRIME;
     }
 
     return hashValue % size;
 }
 
+// Full FNV-1a hash of the first 'length' bytes of the key
+static uint32_t fnv1a(const char *key, size_t length) {
+    uint32_t hashValue = HASH_FNV_OFFSET_BASIS;
+
+    for(size_t i = 0; i < length; i++) {
+        hashValue ^= (unsigned char)key[i];
+        hashValue *= HASH_FNV_PRIME;
+    }
+
+    return hashValue;
+}
+
+// FNV-1a over the first 'length' bytes of the key
+static uint32_t hashN(const char *key, size_t length, size_t size) {
+    return fnv1a(key, length) % size;
+}
+
 static HashSlot *createHashSlot() {
     HashSlot *hashSlot = malloc(sizeof(HashSlot));
 
@@ -76,6 +101,7 @@ static HashSlot *createHashSlot() {
 
     hashSlot->key = NULL;
     hashSlot->value = NULL;
+    hashSlot->hash = 0;
     hashSlot->occupied = false; // Initialize as unoccupied
 
     return hashSlot;
@@ -91,8 +117,7 @@ static void freeNewTable(HashSlot **table, size_t size) {
     table = NULL;
 }
 
-static void hashTableResize(HashTable *hashTable) {
-    size_t newSize = hashTable->size * 2;
+static void hashTableResize(HashTable *hashTable, size_t newSize) {
     HashSlot **newTable = calloc(newSize, sizeof(HashSlot *));
 
     if(!newTable) {
@@ -106,7 +131,7 @@ static void hashTableResize(HashTable *hashTable) {
         HashSlot *current = hashTable->table[i];
 
         if(current && current->occupied) {
-            uint32_t newIndex = hash(current->key, newSize);
+            uint32_t newIndex = current->hash % newSize; // No need to hash the key again
 
             // Linear probing for an empty slot
             while(newTable[newIndex] && newTable[newIndex]->occupied)
@@ -125,6 +150,7 @@ static void hashTableResize(HashTable *hashTable) {
 
             newTable[newIndex]->key = current->key;
             newTable[newIndex]->value = current->value;
+            newTable[newIndex]->hash = current->hash;
             newTable[newIndex]->occupied = true;
             
             free(current);
@@ -140,28 +166,34 @@ static void hashTableResize(HashTable *hashTable) {
     hashTable->table = newTable;
 }
 
-static void hashTableSet(HashTable *hashTable, const char *key, void *value) {
+// Stores the key, or leaves an existing one alone unless 'replace' is set. Returns false if nothing was stored.
+static bool hashTablePut(HashTable *hashTable, const char *key, void *value, bool replace) {
     if(!hashTable || hashTable->size == 0) {
         fputs("Cannot set a value for an unallocated hash table.\n", stderr);
-        return;
+        return false;
     }
     else if(!key || !value) {
         fputs("Key or value cannot be NULL.\n", stderr);
-        return;
+        return false;
     }
     else if(*key == '\0') {
         fputs("Key cannot be an empty string.\n", stderr);
-        return;
+        return false;
     }
 
     if((float)hashTable->elementCount / (float)hashTable->size > LOAD_FACTOR_THRESHOLD)
-        hashTableResize(hashTable);
+        hashTableResize(hashTable, hashTable->size * 2);
     
-    size_t index = hash(key, hashTable->size);
+    uint32_t fullHash = fnv1a(key, strlen(key));
+    size_t index = fullHash % hashTable->size;
 
     while(hashTable->table[index] && hashTable->table[index]->occupied) {
-        if(strcmp(hashTable->table[index]->key, key) == 0)
+        if(hashTable->table[index]->hash == fullHash && strcmp(hashTable->table[index]->key, key) == 0) {
+            if(!replace)
+                return false;
+
             break;
+        }
 
         index = (index + 1) % hashTable->size;
     }
@@ -174,7 +206,7 @@ static void hashTableSet(HashTable *hashTable, const char *key, void *value) {
             hashTableFree(&hashTable);
             memAllocError("hash slot");
 
-            return;
+            return false;
         }
     }
 
@@ -185,7 +217,33 @@ static void hashTableSet(HashTable *hashTable, const char *key, void *value) {
 
     current->key = key;
     current->value = value;
+    current->hash = fullHash;
     current->occupied = true;
+
+    return true;
+}
+
+static void hashTableSet(HashTable *hashTable, const char *key, void *value) {
+    hashTablePut(hashTable, key, value, true);
+}
+
+// Set and duplicate check in one probe
+static bool hashTableInsert(HashTable *hashTable, const char *key, void *value) {
+    return hashTablePut(hashTable, key, value, false);
+}
+
+// Grows the table once so 'count' more keys fit without resizing one doubling at a time
+static void hashTableReserve(HashTable *hashTable, size_t count) {
+    if(!hashTable || hashTable->size == 0)
+        return;
+
+    size_t newSize = hashTable->size;
+
+    while((float)(hashTable->elementCount + count) / (float)newSize > LOAD_FACTOR_THRESHOLD)
+        newSize *= 2;
+
+    if(newSize > hashTable->size)
+        hashTableResize(hashTable, newSize);
 }
 
 static const void *hashTableGet(HashTable *hashTable, const char *key) {
@@ -205,6 +263,46 @@ static const void *hashTableGet(HashTable *hashTable, const char *key) {
     return NULL;
 }
 
+static const void *hashTableGetN(HashTable *hashTable, const char *key, size_t length) {
+    if(!hashTable || hashTable->elementCount == 0 || !key || length == 0)
+        return NULL;
+
+    size_t index = hashN(key, length, hashTable->size);
+
+    // Linear probing to find the key
+    while(hashTable->table[index] && hashTable->table[index]->occupied) {
+        const char *slotKey = hashTable->table[index]->key;
+
+        if(strncmp(slotKey, key, length) == 0 && slotKey[length] == '\0')
+            return hashTable->table[index]->value;
+
+        index = (index + 1) % hashTable->size;
+    }
+
+    return NULL;
+}
+
+// Lookup with a hash computed by the caller (FNV-1a over the 'length' bytes of the key, HASH_FNV_* parameters),
+// the key bytes are only compared against a slot whose full hash matches
+static const void *hashTableGetHashed(HashTable *hashTable, const char *key, size_t length, uint32_t hash) {
+    if(!hashTable || hashTable->elementCount == 0 || !key || length == 0)
+        return NULL;
+
+    size_t index = hash % hashTable->size;
+
+    // Linear probing to find the key
+    while(hashTable->table[index] && hashTable->table[index]->occupied) {
+        const HashSlot *slot = hashTable->table[index];
+
+        if(slot->hash == hash && strncmp(slot->key, key, length) == 0 && slot->key[length] == '\0')
+            return slot->value;
+
+        index = (index + 1) % hashTable->size;
+    }
+
+    return NULL;
+}
+
 static void hashTableDelete(HashTable *hashTable, const char *key) {
     if(!hashTable || hashTable->elementCount == 0 || !key || *key == '\0')
         return;
@@ -309,7 +407,11 @@ HashTable *initHashTable(size_t initSize) {
     }
     
     hashTable->set = hashTableSet;
+    hashTable->insert = hashTableInsert;
+    hashTable->reserve = hashTableReserve;
     hashTable->get = hashTableGet;
+    hashTable->getN = hashTableGetN;
+    hashTable->getHashed = hashTableGetHashed;
     hashTable->delete = hashTableDelete;
     hashTable->has = hashTableHas;
     hashTable->free = hashTableFree;
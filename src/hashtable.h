@@ -4,9 +4,18 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// FNV-1a (Fowler-Noll-Vo) parameters, for callers hashing keys themselves (see getHashed)
+#define HASH_FNV_OFFSET_BASIS 2166136261u
+#define HASH_FNV_PRIME 16777619u
+
 typedef struct {
     const char *key;
     void *value;
+    uint32_t hash; // Full FNV-1a hash of the key, compared before the key itself
     bool occupied;
 } HashSlot;
 
@@ -17,22 +26,37 @@ struct HashTable {
     size_t elementCount;
     HashSlot **table;
 
-    void (*set)(HashTable *this, const char *key, void *value);
-    const void *(*get)(HashTable *this, const char *key);
-    void (*delete)(HashTable *this, const char *key);
-    bool (*has)(HashTable *this, const char *key);
-    void (*free)(HashTable **this);
-    size_t (*getSize)(HashTable *this);
-    size_t (*count)(HashTable *this);
+    void (*set)(HashTable *hashTable, const char *key, void *value);
+    bool (*insert)(HashTable *hashTable, const char *key, void *value); // False if the key is already set
+    void (*reserve)(HashTable *hashTable, size_t count);
+    const void *(*get)(HashTable *hashTable, const char *key);
+    const void *(*getN)(HashTable *hashTable, const char *key, size_t length);
+    const void *(*getHashed)(HashTable *hashTable, const char *key, size_t length, uint32_t hash);
+#ifdef __cplusplus
+    void (*deleteKey)(HashTable *hashTable, const char *key); // 'delete' is a keyword in C++, same slot
+#else
+    void (*delete)(HashTable *hashTable, const char *key);
+#endif
+    bool (*has)(HashTable *hashTable, const char *key);
+    void (*free)(HashTable **hashTable);
+    size_t (*getSize)(HashTable *hashTable);
+    size_t (*count)(HashTable *hashTable);
 };
 
 static void memAllocError(const char *err);
 static uint32_t hash(const char *key, size_t size);
-static void hashTableResize(HashTable *hashTable);
+static uint32_t hashN(const char *key, size_t length, size_t size);
+static uint32_t fnv1a(const char *key, size_t length);
+static void hashTableResize(HashTable *hashTable, size_t newSize);
 static HashSlot *createHashSlot();
 static void freeNewTable(HashSlot **table, size_t size);
+static bool hashTablePut(HashTable *hashTable, const char *key, void *value, bool replace);
 static void hashTableSet(HashTable *hashTable, const char *key, void *value);
+static bool hashTableInsert(HashTable *hashTable, const char *key, void *value);
+static void hashTableReserve(HashTable *hashTable, size_t count);
 static const void *hashTableGet(HashTable *hashTable, const char *key);
+static const void *hashTableGetN(HashTable *hashTable, const char *key, size_t length);
+static const void *hashTableGetHashed(HashTable *hashTable, const char *key, size_t length, uint32_t hash);
 static void hashTableDelete(HashTable *hashTable, const char *key);
 static bool hashTableHas(HashTable *hashTable, const char *key);
 static void hashTableFree(HashTable **hashTablePtr);
@@ -40,4 +64,8 @@ static size_t hashTableSize(HashTable *hashTable);
 static size_t hashTableCount(HashTable *hashTable);
 HashTable *initHashTable(size_t initSize);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,192 @@
+/*
+    Generic Thread Pool Implementation in C
+    Author: Prox
+
+    Description:
+    A small fixed-size thread pool running batches of independent tasks. The tasks of a batch are
+    numbered, every thread (the workers and the thread calling `run`) claims the next unclaimed
+    task with an atomic increment until none is left, so a thread done early keeps taking work
+    from the threads stuck on longer tasks.
+
+    Features:
+    - Batches: Run `count` tasks and wait for all of them to finish.
+    - Dynamic Load Balancing: Tasks are claimed one by one, not split evenly up front.
+    - Persistent Workers: Threads are created once and sleep between batches.
+
+    Notes:
+    - A batch must not start another batch on the same pool.
+    - Tasks must not exit the thread they run on.
+
+    Functions:
+    - Initialization:
+        Create a pool with a number of worker threads, 0 uses one thread per online CPU.
+    - Execution (`run`):
+        Run a batch of tasks and return once they are all finished.
+    - Memory Management (`free`):
+        Stop and join the workers and release the pool.
+    - Utility:
+      - Get the number of threads working on a batch, the calling thread included (`getThreadCount`).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "threadpool.h"
+
+// Claim and run tasks until the batch has none left
+static void threadPoolWork(ThreadPool *threadPool) {
+    size_t finished = 0;
+    size_t index;
+
+    while((index = __atomic_fetch_add(&threadPool->nextTask, 1, __ATOMIC_RELAXED)) < threadPool->taskCount) {
+        threadPool->task(index, threadPool->userData);
+        finished++;
+    }
+
+    if(finished == 0)
+        return;
+
+    pthread_mutex_lock(&threadPool->mutex);
+
+    threadPool->remaining -= finished;
+
+    if(threadPool->remaining == 0)
+        pthread_cond_broadcast(&threadPool->done);
+
+    pthread_mutex_unlock(&threadPool->mutex);
+}
+
+static void *threadPoolWorker(void *arg) {
+    ThreadPool *threadPool = arg;
+    uint64_t generation = 0;
+
+    pthread_mutex_lock(&threadPool->mutex);
+
+    for(;;) {
+        while(!threadPool->stopping && threadPool->generation == generation)
+            pthread_cond_wait(&threadPool->wake, &threadPool->mutex);
+
+        if(threadPool->stopping)
+            break;
+
+        generation = threadPool->generation;
+        threadPool->busyWorkers++;
+
+        pthread_mutex_unlock(&threadPool->mutex);
+        threadPoolWork(threadPool);
+        pthread_mutex_lock(&threadPool->mutex);
+
+        // The next batch can't reset the counters while a worker still reads them
+        if(--threadPool->busyWorkers == 0)
+            pthread_cond_broadcast(&threadPool->done);
+    }
+
+    pthread_mutex_unlock(&threadPool->mutex);
+
+    return NULL;
+}
+
+static void threadPoolRun(ThreadPool *threadPool, size_t taskCount, ThreadPoolTask task, void *userData) {
+    if(!threadPool || taskCount == 0)
+        return;
+
+    pthread_mutex_lock(&threadPool->mutex);
+
+    while(threadPool->busyWorkers > 0)
+        pthread_cond_wait(&threadPool->done, &threadPool->mutex);
+
+    threadPool->task = task;
+    threadPool->userData = userData;
+    threadPool->taskCount = taskCount;
+    threadPool->nextTask = 0;
+    threadPool->remaining = taskCount;
+    threadPool->generation++;
+
+    pthread_cond_broadcast(&threadPool->wake);
+    pthread_mutex_unlock(&threadPool->mutex);
+
+    threadPoolWork(threadPool); // The calling thread works as well
+
+    pthread_mutex_lock(&threadPool->mutex);
+
+    while(threadPool->remaining > 0)
+        pthread_cond_wait(&threadPool->done, &threadPool->mutex);
+
+    pthread_mutex_unlock(&threadPool->mutex);
+}
+
+static void threadPoolFree(ThreadPool **threadPoolPtr) {
+    ThreadPool *threadPool = *threadPoolPtr;
+
+    if(!threadPool)
+        return;
+
+    pthread_mutex_lock(&threadPool->mutex);
+    threadPool->stopping = true;
+    pthread_cond_broadcast(&threadPool->wake);
+    pthread_mutex_unlock(&threadPool->mutex);
+
+    for(size_t i = 0; i < threadPool->threadCount; i++)
+        pthread_join(threadPool->threads[i], NULL);
+
+    pthread_cond_destroy(&threadPool->wake);
+    pthread_cond_destroy(&threadPool->done);
+    pthread_mutex_destroy(&threadPool->mutex);
+
+    free(threadPool->threads);
+    free(threadPool);
+
+    // Set the caller's pointer to NULL
+    *threadPoolPtr = NULL;
+}
+
+static size_t threadPoolThreadCount(ThreadPool *threadPool) {
+    if(!threadPool) {
+        fputs("Thread pool is NULL.\n", stderr);
+        return 0;
+    }
+
+    return threadPool->threadCount + 1;
+}
+
+ThreadPool *initThreadPool(size_t threadCount) {
+    ThreadPool *threadPool = calloc(1, sizeof(ThreadPool));
+
+    if(!threadPool) {
+        fputs("Cannot allocate a memory for thread pool struct.\n", stderr);
+        return NULL;
+    }
+
+    if(threadCount == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threadCount = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    threadPool->threads = calloc(threadCount, sizeof(pthread_t));
+
+    if(!threadPool->threads) {
+        free(threadPool);
+        fputs("Cannot allocate a memory for thread pool threads.\n", stderr);
+
+        return NULL;
+    }
+
+    pthread_mutex_init(&threadPool->mutex, NULL);
+    pthread_cond_init(&threadPool->wake, NULL);
+    pthread_cond_init(&threadPool->done, NULL);
+
+    threadPool->run = threadPoolRun;
+    threadPool->free = threadPoolFree;
+    threadPool->getThreadCount = threadPoolThreadCount;
+
+    // The calling thread is one of the threads working on a batch
+    for(size_t i = 0; i + 1 < threadCount; i++) {
+        if(pthread_create(&threadPool->threads[i], NULL, threadPoolWorker, threadPool) != 0)
+            break;
+
+        threadPool->threadCount++;
+    }
+
+    return threadPool;
+}
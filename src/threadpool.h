@@ -0,0 +1,49 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One task of a batch, 'index' goes from 0 to the task count of the batch
+typedef void (*ThreadPoolTask)(size_t index, void *userData);
+
+typedef struct ThreadPool ThreadPool;
+
+struct ThreadPool {
+    size_t threadCount; // Worker threads, the thread calling run works too
+    pthread_t *threads;
+    pthread_mutex_t mutex;
+    pthread_cond_t wake; // Signaled when a batch starts or the pool stops
+    pthread_cond_t done; // Signaled when the last task of a batch is over
+    ThreadPoolTask task;
+    void *userData;
+    size_t taskCount;
+    size_t nextTask; // Claimed with an atomic increment, idle threads take the next task
+    size_t remaining; // Tasks not finished yet
+    size_t busyWorkers; // Workers still inside the current batch
+    uint64_t generation; // Incremented for every batch
+    bool stopping;
+
+    void (*run)(ThreadPool *threadPool, size_t taskCount, ThreadPoolTask task, void *userData);
+    void (*free)(ThreadPool **threadPool);
+    size_t (*getThreadCount)(ThreadPool *threadPool);
+};
+
+static void *threadPoolWorker(void *arg);
+static void threadPoolWork(ThreadPool *threadPool);
+static void threadPoolRun(ThreadPool *threadPool, size_t taskCount, ThreadPoolTask task, void *userData);
+static void threadPoolFree(ThreadPool **threadPoolPtr);
+static size_t threadPoolThreadCount(ThreadPool *threadPool);
+ThreadPool *initThreadPool(size_t threadCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
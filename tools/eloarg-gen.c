@@ -0,0 +1,704 @@
+/*
+    eloarg-gen - Option Table Generator for EloArg
+
+    Description:
+    Reads an option spec file and writes a C header declaring the options at compile time,
+    so a program with thousands of options registers them without building anything at startup.
+
+    Spec file:
+    One option per line, '#' starts a comment. Fields are separated by whitespace, '-' marks
+    a missing short or long option and the description runs to the end of the line.
+
+        # id      short  long     value     type     description
+        port      p      port     required  int64    Port to listen on.
+        host      -      host     optional  string   Host to bind.
+        verbose   v      verbose  none      count    Increase verbosity level.
+
+    value is one of none, info, optional, required.
+    type is one of string, bool, count, int64, uint64, double, size, duration.
+    Ids must differ once upper-cased, and option_count is reserved.
+
+    Output (for the prefix 'app'):
+    - `AppOption`: Enum of the option handles, `APP_PORT` ... `APP_OPTION_COUNT`.
+    - `appSpecs`: `EloArgSpec` table in rodata, for `addTable`.
+    - `AppOptions`: Struct with one typed field per option, filled by `parse` through `appBindings`.
+    - `appResolve`: Resolver matching long options with a switch on the length, then on the bytes telling them apart.
+    - `appHelp`: The lines of the options as printed by `help`, precomputed.
+    - `appRegister`: Registers the table, the resolver, the help lines and the bindings in one call.
+
+    Usage:
+        eloarg-gen [-p prefix] spec [output.h]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "../src/eloarg.h"
+
+#define TOOL_NAME "eloarg-gen"
+#define SPEC_LINE_LENGTH 512
+#define SPEC_ID_LENGTH 64
+#define PREFIX_LENGTH 32
+
+// Same layout as printHelp
+#define HELP_PADDING_RIGHT 38
+#define HELP_OPTION_LINE_LENGTH 46
+#define HELP_MAX_DESCRIPTION_SENTENCE_LENGTH 70
+
+typedef struct {
+    char id[SPEC_ID_LENGTH + 1];
+    char shortOption[ELOARG_SHORT_OPTION_LENGTH + 1];
+    char longOption[ELOARG_LONG_OPTION_LENGTH + 1];
+    char description[ELOARG_DESCRIPTION_LENGTH + 1];
+    ArgValueType valueType;
+    ArgDataType dataType;
+    size_t line;
+} Spec;
+
+typedef struct {
+    Spec *items;
+    size_t count;
+    size_t capacity;
+} SpecList;
+
+// Growable buffer for the help string
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} Text;
+
+static const char *specPath;
+
+static void error(const char *formatStr, ...) {
+    va_list args;
+    fprintf(stderr, "%s: ", TOOL_NAME);
+
+    va_start(args, formatStr);
+    vfprintf(stderr, formatStr, args);
+    va_end(args);
+
+    fputc('\n', stderr);
+    exit(EXIT_FAILURE);
+}
+
+static void specError(size_t line, const char *message, const char *field) {
+    error("%s:%zu: %s '%s'.", specPath, line, message, field);
+}
+
+static void textAppend(Text *text, const char *formatStr, ...) {
+    va_list args;
+
+    va_start(args, formatStr);
+    int length = vsnprintf(NULL, 0, formatStr, args);
+    va_end(args);
+
+    if(text->length + length + 1 > text->capacity) {
+        size_t capacity = text->capacity ? text->capacity * 2 : 4096;
+
+        while(capacity < text->length + length + 1)
+            capacity *= 2;
+
+        char *data = realloc(text->data, capacity);
+
+        if(!data)
+            error("Failed to allocate memory for the help string.");
+
+        text->data = data;
+        text->capacity = capacity;
+    }
+
+    va_start(args, formatStr);
+    vsnprintf(text->data + text->length, length + 1, formatStr, args);
+    va_end(args);
+
+    text->length += length;
+}
+
+static bool parseValueType(const char *name, ArgValueType *valueType) {
+    static const char *names[] = { "none", "info", "optional", "required" };
+    static const ArgValueType types[] = { ARG_NONE, ARG_INFO, ARG_OPTIONAL, ARG_REQUIRED };
+
+    for(size_t i = 0; i < sizeof(names) / sizeof(*names); i++)
+        if(strcmp(name, names[i]) == 0) {
+            *valueType = types[i];
+            return true;
+        }
+
+    return false;
+}
+
+static const char *dataTypeNames[] = { "string", "bool", "count", "int64", "uint64", "double", "size", "duration" };
+
+static bool parseDataType(const char *name, ArgDataType *dataType) {
+    for(size_t i = 0; i < sizeof(dataTypeNames) / sizeof(*dataTypeNames); i++)
+        if(strcmp(name, dataTypeNames[i]) == 0) {
+            *dataType = (ArgDataType)i; // Same order as ArgDataType
+            return true;
+        }
+
+    return false;
+}
+
+static bool isIdentifier(const char *name) {
+    if(!isalpha((unsigned char)*name) && *name != '_')
+        return false;
+
+    for(; *name; name++)
+        if(!isalnum((unsigned char)*name) && *name != '_')
+            return false;
+
+    return true;
+}
+
+// Option names end at whitespace and may not contain '=', which separates the value
+static bool isOptionName(const char *name) {
+    if(*name == '-')
+        return false;
+
+    for(; *name; name++)
+        if(*name == '=' || !isgraph((unsigned char)*name))
+            return false;
+
+    return true;
+}
+
+static char *nextField(char **cursor) {
+    char *field = *cursor;
+
+    while(isspace((unsigned char)*field))
+        field++;
+
+    if(*field == '\0')
+        return NULL;
+
+    char *end = field;
+
+    while(*end && !isspace((unsigned char)*end))
+        end++;
+
+    *cursor = *end ? end + 1 : end;
+    *end = '\0';
+
+    return field;
+}
+
+static void addSpec(SpecList *specs, const Spec *spec) {
+    if(specs->count == specs->capacity) {
+        size_t capacity = specs->capacity ? specs->capacity * 2 : 64;
+        Spec *items = realloc(specs->items, capacity * sizeof(Spec));
+
+        if(!items)
+            error("Failed to allocate memory for the option specs.");
+
+        specs->items = items;
+        specs->capacity = capacity;
+    }
+
+    specs->items[specs->count++] = *spec;
+}
+
+static void checkDuplicates(const SpecList *specs) {
+    // Hash table of the ids and names, the spec file may hold thousands of options
+    HashTable *seen = initHashTable(specs->count * 6 + 1);
+    char *ids = malloc(specs->count * (SPEC_ID_LENGTH + 2));
+
+    if(!ids)
+        error("Failed to allocate memory for the option ids.");
+
+    for(size_t i = 0; i < specs->count; i++) {
+        const Spec *spec = &specs->items[i];
+        char *id = ids + i * (SPEC_ID_LENGTH + 2);
+
+        // Ids live in their own namespace, prefixed with a byte the option names can't contain. They are
+        // compared upper-cased, as they appear in the enum constants
+        snprintf(id, SPEC_ID_LENGTH + 2, " %s", spec->id);
+
+        for(char *c = id; *c; c++)
+            *c = toupper((unsigned char)*c);
+
+        if(strcmp(id + 1, "OPTION_COUNT") == 0)
+            specError(spec->line, "Reserved id", spec->id);
+        else if(seen->has(seen, id))
+            specError(spec->line, "Duplicate id", spec->id);
+        else if(*spec->shortOption && seen->has(seen, spec->shortOption))
+            specError(spec->line, "Duplicate option", spec->shortOption);
+        else if(*spec->longOption && seen->has(seen, spec->longOption))
+            specError(spec->line, "Duplicate option", spec->longOption);
+
+        seen->set(seen, id, (void *)spec);
+
+        if(*spec->shortOption)
+            seen->set(seen, spec->shortOption, (void *)spec);
+
+        if(*spec->longOption)
+            seen->set(seen, spec->longOption, (void *)spec);
+    }
+
+    seen->free(&seen);
+    free(ids);
+}
+
+static SpecList readSpecs(const char *path) {
+    FILE *file = fopen(path, "r");
+
+    if(!file)
+        error("Cannot open the spec file '%s'.", path);
+
+    SpecList specs = { NULL, 0, 0 };
+    char line[SPEC_LINE_LENGTH];
+    size_t lineNumber = 0;
+
+    while(fgets(line, sizeof(line), file)) {
+        lineNumber++;
+
+        size_t length = strlen(line);
+
+        if(length == sizeof(line) - 1 && line[length - 1] != '\n' && !feof(file))
+            error("%s:%zu: Line too long.", path, lineNumber);
+
+        char *comment = strchr(line, '#');
+
+        if(comment)
+            *comment = '\0';
+
+        char *cursor = line;
+        char *id = nextField(&cursor);
+
+        if(!id)
+            continue;
+
+        char *shortOption = nextField(&cursor);
+        char *longOption = nextField(&cursor);
+        char *valueType = nextField(&cursor);
+        char *dataType = nextField(&cursor);
+
+        if(!dataType)
+            error("%s:%zu: Expected 'id short long value type description'.", path, lineNumber);
+
+        while(isspace((unsigned char)*cursor))
+            cursor++;
+
+        char *description = cursor;
+        char *end = description + strlen(description);
+
+        while(end > description && isspace((unsigned char)*(end - 1)))
+            *--end = '\0';
+
+        Spec spec = { .line = lineNumber };
+
+        if(!isIdentifier(id) || strlen(id) > SPEC_ID_LENGTH)
+            specError(lineNumber, "Invalid id", id);
+
+        strcpy(spec.id, id);
+
+        if(strcmp(shortOption, "-") != 0) {
+            if(strlen(shortOption) > ELOARG_SHORT_OPTION_LENGTH || !isOptionName(shortOption))
+                specError(lineNumber, "Invalid short option", shortOption);
+
+            strcpy(spec.shortOption, shortOption);
+        }
+
+        if(strcmp(longOption, "-") != 0) {
+            if(strlen(longOption) > ELOARG_LONG_OPTION_LENGTH || !isOptionName(longOption))
+                specError(lineNumber, "Invalid long option", longOption);
+
+            strcpy(spec.longOption, longOption);
+        }
+
+        if(!*spec.shortOption && !*spec.longOption)
+            specError(lineNumber, "Missing short and long option for", id);
+        else if(!*description)
+            specError(lineNumber, "Missing description for", id);
+        else if(strlen(description) > ELOARG_DESCRIPTION_LENGTH)
+            specError(lineNumber, "Description too long for", id);
+        else if(!parseValueType(valueType, &spec.valueType))
+            specError(lineNumber, "Unknown value type", valueType);
+        else if(!parseDataType(dataType, &spec.dataType))
+            specError(lineNumber, "Unknown type", dataType);
+
+        // Flags only count or switch, like bind
+        if((spec.valueType == ARG_NONE || spec.valueType == ARG_INFO)
+            && spec.dataType != ARG_TYPE_BOOL && spec.dataType != ARG_TYPE_COUNT)
+            specError(lineNumber, "Options without a value must be bool or count:", id);
+
+        strcpy(spec.description, description);
+        addSpec(&specs, &spec);
+    }
+
+    fclose(file);
+
+    if(specs.count == 0)
+        error("No options in the spec file '%s'.", path);
+
+    checkDuplicates(&specs);
+
+    return specs;
+}
+
+static void writeString(FILE *out, const char *str) {
+    fputc('"', out);
+
+    for(; *str; str++) {
+        if(*str == '"' || *str == '\\')
+            fprintf(out, "\\%c", *str);
+        else if(*str == '\n')
+            fputs("\\n", out);
+        else if(isprint((unsigned char)*str))
+            fputc(*str, out);
+        else
+            fprintf(out, "\\%03o", (unsigned char)*str);
+    }
+
+    fputc('"', out);
+}
+
+static void writeUpper(FILE *out, const char *str) {
+    for(; *str; str++)
+        fputc(toupper((unsigned char)*str), out);
+}
+
+static void writeIndent(FILE *out, int depth) {
+    fprintf(out, "%*s", depth * 4, "");
+}
+
+static void writeCase(FILE *out, unsigned char byte) {
+    if(byte == '\'' || byte == '\\')
+        fprintf(out, "'\\%c'", byte);
+    else if(isprint(byte))
+        fprintf(out, "'%c'", byte);
+    else
+        fprintf(out, "%u", byte);
+}
+
+// Switches on the byte telling the most names apart until one name is left, then compares it whole
+static void writeMatcher(FILE *out, const char *prefix, const Spec **group, size_t count, size_t length, int depth) {
+    if(count == 1) {
+        writeIndent(out, depth);
+        fputs("return memcmp(name, ", out);
+        writeString(out, group[0]->longOption);
+        fprintf(out, ", %zu) == 0 ? %sBase + ", length, prefix);
+        writeUpper(out, prefix);
+        fputc('_', out);
+        writeUpper(out, group[0]->id);
+        fputs(" : ELOARG_INVALID_ID;\n", out);
+        return;
+    }
+
+    size_t bestPosition = 0, bestDistinct = 0;
+
+    for(size_t position = 0; position < length; position++) {
+        bool present[UINT8_MAX + 1] = { false };
+        size_t distinct = 0;
+
+        for(size_t i = 0; i < count; i++) {
+            unsigned char byte = group[i]->longOption[position];
+
+            distinct += !present[byte];
+            present[byte] = true;
+        }
+
+        if(distinct > bestDistinct) {
+            bestDistinct = distinct;
+            bestPosition = position;
+        }
+    }
+
+    writeIndent(out, depth);
+    fprintf(out, "switch((unsigned char)name[%zu]) {\n", bestPosition);
+
+    const Spec **subgroup = malloc(count * sizeof(Spec *));
+    bool *done = calloc(count, sizeof(bool));
+
+    if(!subgroup || !done)
+        error("Failed to allocate memory for the matcher.");
+
+    for(size_t i = 0; i < count; i++) {
+        if(done[i])
+            continue;
+
+        unsigned char byte = group[i]->longOption[bestPosition];
+        size_t subcount = 0;
+
+        for(size_t j = i; j < count; j++)
+            if(!done[j] && (unsigned char)group[j]->longOption[bestPosition] == byte) {
+                subgroup[subcount++] = group[j];
+                done[j] = true;
+            }
+
+        writeIndent(out, depth + 1);
+        fputs("case ", out);
+        writeCase(out, byte);
+        fputs(":\n", out);
+        writeMatcher(out, prefix, subgroup, subcount, length, depth + 2);
+    }
+
+    writeIndent(out, depth);
+    fputs("}\n", out);
+    writeIndent(out, depth);
+    fputs("return ELOARG_INVALID_ID;\n", out);
+
+    free(subgroup);
+    free(done);
+}
+
+static void writeResolver(FILE *out, const char *prefix, const SpecList *specs) {
+    const Spec **group = malloc(specs->count * sizeof(Spec *));
+
+    if(!group)
+        error("Failed to allocate memory for the matcher.");
+
+    fprintf(out, "static EloArgId %sResolve(const char *name, size_t length) {\n", prefix);
+    fputs("    switch(length) {\n", out);
+
+    for(size_t length = 1; length <= ELOARG_LONG_OPTION_LENGTH; length++) {
+        size_t count = 0;
+
+        for(size_t i = 0; i < specs->count; i++)
+            if(strlen(specs->items[i].longOption) == length)
+                group[count++] = &specs->items[i];
+
+        if(count == 0)
+            continue;
+
+        fprintf(out, "        case %zu:\n", length);
+        writeMatcher(out, prefix, group, count, length, 3);
+    }
+
+    fputs("    }\n\n    return ELOARG_INVALID_ID;\n}\n\n", out);
+    free(group);
+}
+
+// Same wrapping as printDescription
+static void appendDescription(Text *text, const char *description) {
+    size_t length = 0;
+    const char *wordStart = description;
+
+    while(*description != '\0') {
+        bool blank = *description == ' ' || *description == '\t';
+
+        if(blank || *(description + 1) == '\0') {
+            int wordLen = description - wordStart + !blank; // The last word ends with the string
+
+            if(length + wordLen + (length > 0) <= HELP_MAX_DESCRIPTION_SENTENCE_LENGTH) {
+                textAppend(text, "%s%.*s", length > 0 ? " " : "", wordLen, wordStart);
+                length += wordLen + (length > 0);
+            }
+            else {
+                textAppend(text, "\n%*s%.*s", HELP_OPTION_LINE_LENGTH, "", wordLen, wordStart);
+                length = wordLen;
+            }
+
+            wordStart = description + 1;
+        }
+
+        description++;
+    }
+
+    textAppend(text, "\n");
+}
+
+static void writeHelp(FILE *out, const char *prefix, const SpecList *specs) {
+    Text help = { NULL, 0, 0 };
+
+    for(size_t i = 0; i < specs->count; i++) {
+        const Spec *spec = &specs->items[i];
+
+        if(*spec->shortOption && *spec->longOption)
+            textAppend(&help, "  -%s, --%s%-*s", spec->shortOption, spec->longOption,
+                HELP_PADDING_RIGHT - (int)strlen(spec->longOption), "");
+        else if(*spec->shortOption)
+            textAppend(&help, "  -%s%-*s", spec->shortOption, HELP_PADDING_RIGHT, "");
+        else
+            textAppend(&help, "      --%s%-*s", spec->longOption,
+                HELP_PADDING_RIGHT - (int)strlen(spec->longOption), "");
+
+        appendDescription(&help, spec->description);
+    }
+
+    fprintf(out, "// Lines of the options as printed by help, installed with setHelp\nstatic const char %sHelp[] =", prefix);
+
+    // One literal per help line
+    for(char *line = help.data; *line;) {
+        char *end = strchr(line, '\n');
+        size_t length = end ? (size_t)(end - line) + 1 : strlen(line);
+        char saved = line[length];
+
+        line[length] = '\0';
+        fputs("\n    ", out);
+        writeString(out, line);
+        line[length] = saved;
+        line += length;
+    }
+
+    fputs(";\n\n", out);
+    free(help.data);
+}
+
+static const char *fieldType(ArgDataType type) {
+    switch(type) {
+        case ARG_TYPE_BOOL:
+            return "bool";
+        case ARG_TYPE_COUNT:
+            return "size_t";
+        case ARG_TYPE_INT64:
+            return "int64_t";
+        case ARG_TYPE_DOUBLE:
+            return "double";
+        case ARG_TYPE_UINT64:
+        case ARG_TYPE_SIZE:
+        case ARG_TYPE_DURATION:
+            return "uint64_t";
+        default:
+            return "const char *";
+    }
+}
+
+static const char *dataTypeConstant(ArgDataType type) {
+    static const char *constants[] = {
+        "ARG_TYPE_STRING", "ARG_TYPE_BOOL", "ARG_TYPE_COUNT", "ARG_TYPE_INT64",
+        "ARG_TYPE_UINT64", "ARG_TYPE_DOUBLE", "ARG_TYPE_SIZE", "ARG_TYPE_DURATION"
+    };
+
+    return constants[type];
+}
+
+static const char *valueTypeConstant(ArgValueType type) {
+    static const char *constants[] = { "ARG_NONE", "ARG_INFO", "ARG_OPTIONAL", "ARG_REQUIRED" };
+
+    return constants[type];
+}
+
+static void writeHeader(FILE *out, const char *prefix, const SpecList *specs) {
+    char typeName[PREFIX_LENGTH + 1];
+
+    strcpy(typeName, prefix);
+    *typeName = toupper((unsigned char)*typeName);
+
+    fprintf(out, "// Generated by %s from %s, do not edit.\n\n", TOOL_NAME, specPath);
+    fputs("#ifndef ", out);
+    writeUpper(out, prefix);
+    fputs("_OPTIONS_H\n#define ", out);
+    writeUpper(out, prefix);
+    fputs("_OPTIONS_H\n\n#include <string.h>\n#include <stdint.h>\n#include <stdbool.h>\n#include <eloarg.h>\n\n", out);
+
+    // Handles
+    fputs("typedef enum {\n", out);
+
+    for(size_t i = 0; i < specs->count; i++) {
+        fputs("    ", out);
+        writeUpper(out, prefix);
+        fputc('_', out);
+        writeUpper(out, specs->items[i].id);
+        fputs(",\n", out);
+    }
+
+    fputs("    ", out);
+    writeUpper(out, prefix);
+    fprintf(out, "_OPTION_COUNT\n} %sOption;\n\n", typeName);
+
+    // Table, counted options are converted by their binding
+    fprintf(out, "static const EloArgSpec %sSpecs[] = {\n", prefix);
+
+    for(size_t i = 0; i < specs->count; i++) {
+        const Spec *spec = &specs->items[i];
+
+        fputs("    { ", out);
+
+        if(*spec->shortOption)
+            writeString(out, spec->shortOption);
+        else
+            fputs("NULL", out);
+
+        fputs(", ", out);
+
+        if(*spec->longOption)
+            writeString(out, spec->longOption);
+        else
+            fputs("NULL", out);
+
+        fputs(", ", out);
+        writeString(out, spec->description);
+        fprintf(out, ", %s, %s },\n", valueTypeConstant(spec->valueType),
+            dataTypeConstant(spec->dataType == ARG_TYPE_COUNT ? ARG_TYPE_STRING : spec->dataType));
+    }
+
+    fputs("};\n\n", out);
+
+    // Typed results
+    fputs("typedef struct {\n", out);
+
+    for(size_t i = 0; i < specs->count; i++) {
+        const char *type = fieldType(specs->items[i].dataType);
+
+        fprintf(out, "    %s%s%s;\n", type, type[strlen(type) - 1] == '*' ? "" : " ", specs->items[i].id);
+    }
+
+    fprintf(out, "} %sOptions;\n\n", typeName);
+
+    fprintf(out, "static const EloArgBinding %sBindings[] = {\n", prefix);
+
+    for(size_t i = 0; i < specs->count; i++) {
+        const Spec *spec = &specs->items[i];
+
+        fprintf(out, "    ELOARG_BINDING(%sOptions, %s, ", typeName, spec->id);
+        writeString(out, *spec->longOption ? spec->longOption : spec->shortOption);
+        fprintf(out, ", %s),\n", dataTypeConstant(spec->dataType));
+    }
+
+    fputs("};\n\n", out);
+
+    writeHelp(out, prefix, specs);
+
+    fprintf(out, "static EloArgId %sBase; // Handle of the first option, set by %sRegister\n\n", prefix, prefix);
+    writeResolver(out, prefix, specs);
+
+    fprintf(out, "// Registers the options and binds them to the fields of 'options', returns the handle of the first one\n");
+    fprintf(out, "static EloArgId %sRegister(EloArg *eloarg, %sOptions *options) {\n", prefix, typeName);
+    fprintf(out, "    %sBase = eloarg->addTable(%sSpecs, ", prefix, prefix);
+    writeUpper(out, prefix);
+    fputs("_OPTION_COUNT);\n", out);
+    fprintf(out, "    eloarg->setResolver(%sResolve);\n", prefix);
+    fprintf(out, "    eloarg->setHelp(%sBase, ", prefix);
+    writeUpper(out, prefix);
+    fprintf(out, "_OPTION_COUNT, %sHelp);\n", prefix);
+    fprintf(out, "    eloarg->bindStruct(options, %sBindings, ", prefix);
+    writeUpper(out, prefix);
+    fprintf(out, "_OPTION_COUNT);\n\n    return %sBase;\n}\n\n#endif\n", prefix);
+}
+
+int main(int argc, char **argv) {
+    const char *prefix = "app";
+    int argument = 1;
+
+    if(argument + 1 < argc && strcmp(argv[argument], "-p") == 0) {
+        prefix = argv[argument + 1];
+        argument += 2;
+    }
+
+    if(argument >= argc || argc - argument > 2)
+        error("Usage: %s [-p prefix] spec [output.h]", TOOL_NAME);
+    else if(!isIdentifier(prefix) || strlen(prefix) > PREFIX_LENGTH)
+        error("Invalid prefix '%s'.", prefix);
+
+    specPath = argv[argument];
+
+    SpecList specs = readSpecs(specPath);
+    FILE *out = argument + 1 < argc ? fopen(argv[argument + 1], "w") : stdout;
+
+    if(!out)
+        error("Cannot open the output file '%s'.", argv[argument + 1]);
+
+    writeHeader(out, prefix, &specs);
+
+    if(out != stdout && fclose(out) != 0)
+        error("Failed to write the output file '%s'.", argv[argument + 1]);
+
+    free(specs.items);
+
+    return 0;
+}